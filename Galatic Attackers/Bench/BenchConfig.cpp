@@ -0,0 +1,12 @@
+#include "../Source/GameConfig.h"
+
+// the benches always start from the shipped defaults (path set by CMake) and
+// tweak settings in memory, so unlike the game nothing is written to saved.ini
+GameConfig::GameConfig() : ini::IniFile()
+{
+	(*this).load(GAME_DEFAULTS_INI);
+}
+
+GameConfig::~GameConfig()
+{
+}
@@ -0,0 +1,225 @@
+// Feeds synthetic OBBs through the collision paths PhysicsLogic can use and checks they agree
+// usage: CollisionBench [boxes] [frames]
+#include "../Source/Utils/Broadphase.h"
+#include "../Source/Utils/OBBBatch.h"
+#include "../Source/Utils/Random.h"
+#include "../Source/Components/Identification.h"
+#include "../Source/Systems/PhysicsLogic.h"
+
+namespace
+{
+	using GA::SweepAndPrune;
+	using PAIRS = std::vector<SweepAndPrune::PAIR>;
+
+	// boxes about the size of the game's ships, spread so each one touches a few neighbours
+	void MakeBoxes(GA::Random& random, unsigned count, std::vector<GW::MATH::GOBBF>& boxes)
+	{
+		float side = std::sqrt(static_cast<float>(count)) * 12.0f;
+		boxes.resize(count);
+		for (auto& box : boxes) {
+			float angle = random.Range(-3.14159f, 3.14159f);
+			box.center = { random.Range(0.0f, side), random.Range(0.0f, side), 0.0f, 1.0f };
+			box.extent = { random.Range(1.0f, 5.0f), random.Range(1.0f, 5.0f), 1.0f, 0.0f };
+			box.rotation = { 0.0f, 0.0f, std::sin(angle * 0.5f), std::cos(angle * 0.5f) };
+		}
+	}
+
+	// everything drifts a little each frame, like enemies in formation
+	void MoveBoxes(GA::Random& random, std::vector<GW::MATH::GOBBF>& boxes)
+	{
+		for (auto& box : boxes) {
+			box.center.x += random.Range(-0.5f, 0.5f);
+			box.center.y += random.Range(-0.5f, 0.5f);
+		}
+	}
+
+	bool Touching(const GW::MATH::GOBBF& a, const GW::MATH::GOBBF& b)
+	{
+		GW::MATH::GCollision::GCollisionCheck result;
+		GW::MATH::GCollision::TestOBBToOBBF(a, b, result);
+		return result == GW::MATH::GCollision::GCollisionCheck::COLLISION;
+	}
+
+	void SortPairs(PAIRS& pairs)
+	{
+		std::sort(pairs.begin(), pairs.end(), [](const SweepAndPrune::PAIR& a, const SweepAndPrune::PAIR& b) {
+			return (a.first != b.first) ? a.first < b.first : a.second < b.second;
+		});
+	}
+
+	bool SamePairs(const PAIRS& a, const PAIRS& b)
+	{
+		return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(),
+			[](const SweepAndPrune::PAIR& x, const SweepAndPrune::PAIR& y) {
+				return x.first == y.first && x.second == y.second;
+			});
+	}
+
+	// the old loop, every pair gets an OBB test
+	void Brute(const std::vector<GW::MATH::GOBBF>& boxes, PAIRS& out)
+	{
+		out.clear();
+		unsigned count = static_cast<unsigned>(boxes.size());
+		for (unsigned i = 0; i < count; ++i)
+			for (unsigned j = i + 1; j < count; ++j)
+				if (Touching(boxes[i], boxes[j]))
+					out.push_back({ i, j });
+	}
+
+	// sweep and prune, one GCollision test per overlapping pair (batch=false)
+	void Sweep(SweepAndPrune& broadphase, const std::vector<GW::MATH::GOBBF>& boxes, PAIRS& out)
+	{
+		out.clear();
+		unsigned count = static_cast<unsigned>(boxes.size());
+		broadphase.Update(boxes.data(), count);
+		for (unsigned i = 0; i < count; ++i) {
+			unsigned a = broadphase.Sorted(i);
+			unsigned overlaps = broadphase.Overlaps(i);
+			for (unsigned j = i + 1; j <= i + overlaps; ++j) {
+				unsigned b = broadphase.Sorted(j);
+				SweepAndPrune::PAIR pair = (a < b) ? SweepAndPrune::PAIR{ a, b } : SweepAndPrune::PAIR{ b, a };
+				if (Touching(boxes[pair.first], boxes[pair.second]))
+					out.push_back(pair);
+			}
+		}
+		SortPairs(out);
+	}
+
+	// sweep and prune with the batched narrowphase (batch=true), what the game runs by default
+	void SweepBatch(SweepAndPrune& broadphase, GA::OBBBatch& batch,
+		const std::vector<GW::MATH::GOBBF>& boxes, PAIRS& out)
+	{
+		out.clear();
+		unsigned count = static_cast<unsigned>(boxes.size());
+		broadphase.Update(boxes.data(), count);
+		batch.Clear();
+		for (unsigned i = 0; i < count; ++i)
+			batch.Add(boxes[broadphase.Sorted(i)], broadphase.Sorted(i));
+		std::vector<unsigned> candidates;
+		std::vector<unsigned char> hits;
+		for (unsigned i = 0; i < count; ++i) {
+			unsigned overlaps = broadphase.Overlaps(i);
+			if (overlaps == 0)
+				continue;
+			candidates.clear();
+			for (unsigned j = i + 1; j <= i + overlaps; ++j)
+				candidates.push_back(j);
+			hits.resize(overlaps);
+			batch.TestList(i, candidates.data(), overlaps, hits.data());
+			unsigned a = broadphase.Sorted(i);
+			for (unsigned j = 0; j < overlaps; ++j) {
+				if (hits[j] == 0)
+					continue;
+				unsigned b = broadphase.Sorted(candidates[j]);
+				out.push_back((a < b) ? SweepAndPrune::PAIR{ a, b } : SweepAndPrune::PAIR{ b, a });
+			}
+		}
+		SortPairs(out);
+	}
+
+	template<typename Func>
+	double Time(Func&& func)
+	{
+		auto start = std::chrono::steady_clock::now();
+		func();
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	// every contact of every frame as entity id pairs, smaller id first
+	using CONTACT_LOG = std::vector<std::pair<flecs::entity_t, flecs::entity_t>>;
+
+	// the whole Gather/Workers/Detect pipeline on the same boxes, returns ms per frame
+	// boxes are split into enemies, bullets and shields (one table each) so the [CollisionLayers]
+	// filter runs, and each group moves on its own schedule so the contact cache gets used
+	double RunPhysics(std::vector<GW::MATH::GOBBF> boxes, unsigned frames, unsigned threads, bool cache,
+		CONTACT_LOG& outContacts)
+	{
+		auto config = std::make_shared<GameConfig>();
+		(*config)["Physics"]["threads"] = static_cast<int>(threads);
+		(*config)["Physics"]["cache"] = cache;
+		auto world = std::make_shared<flecs::world>();
+		std::vector<flecs::entity> entities;
+		for (unsigned i = 0; i < boxes.size(); ++i) {
+			flecs::entity e = world->entity()
+				.add<GA::Collidable>()
+				.set<GA::Position>({ { 0.0f, 100.0f } }) // inside the Cleanup System's bounds
+				.set<GA::Orientation>({ GW::MATH2D::GIdentityMatrix2F })
+				.set<GA::ModelBoundary>({ boxes[i] });
+			switch (i % 3) {
+			case 0: e.add<GA::Enemy>().set<GA::CollisionLayer>({ GA::LAYER_ENEMY }); break;
+			case 1: e.add<GA::Bullet>().set<GA::CollisionLayer>({ GA::LAYER_BULLET }); break;
+			case 2: e.add<GA::Shield>().set<GA::CollisionLayer>({ GA::LAYER_SHIELD }); break;
+			}
+			entities.push_back(e);
+		}
+		GA::PhysicsLogic physics;
+		physics.Init(world, config, nullptr);
+		// same seed every run so each thread count sees the same motion
+		GA::Random random(5678);
+		double ms = 0;
+		outContacts.clear();
+		for (unsigned f = 0; f < frames; ++f) {
+			ms += Time([&] { world->progress(); });
+			for (const auto& pair : world->get<GA::Contacts>()->pairs)
+				outContacts.push_back(std::minmax(pair.a.id(), pair.b.id()));
+			outContacts.push_back({ 0, 0 }); // end of frame
+			// bullets move every frame but every 4th, enemies every other frame, shields never
+			MoveBoxes(random, boxes);
+			for (unsigned i = 0; i < boxes.size(); ++i) {
+				bool moves = (i % 3 == 0) ? (f % 2 == 0) : (i % 3 == 1) ? (f % 4 != 3) : false;
+				if (moves == false)
+					continue;
+				entities[i].get_mut<GA::ModelBoundary>()->obb = boxes[i];
+				entities[i].modified<GA::ModelBoundary>();
+			}
+		}
+		physics.Shutdown();
+		return ms / frames;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	unsigned count = (argc > 1) ? static_cast<unsigned>(std::atoi(argv[1])) : 2000;
+	unsigned frames = (argc > 2) ? static_cast<unsigned>(std::atoi(argv[2])) : 20;
+	GA::Random random(1234);
+	std::vector<GW::MATH::GOBBF> boxes;
+	MakeBoxes(random, count, boxes);
+
+	SweepAndPrune broadphase;
+	GA::OBBBatch batch;
+	PAIRS brute, sweep, batched;
+	double bruteMs = 0, sweepMs = 0, batchMs = 0;
+	size_t pairs = 0;
+	unsigned mismatches = 0;
+	for (unsigned f = 0; f < frames; ++f) {
+		bruteMs += Time([&] { Brute(boxes, brute); });
+		sweepMs += Time([&] { Sweep(broadphase, boxes, sweep); });
+		batchMs += Time([&] { SweepBatch(broadphase, batch, boxes, batched); });
+		// all three visit the same boxes so the pair sets must match exactly
+		if (!SamePairs(brute, sweep) || !SamePairs(brute, batched))
+			++mismatches;
+		pairs += brute.size();
+		MoveBoxes(random, boxes);
+	}
+	std::cout << count << " boxes, " << frames << " frames, avg " << pairs / double(frames) << " colliding pairs\n"
+		<< "  brute            " << bruteMs / frames << "ms\n"
+		<< "  sweep            " << sweepMs / frames << "ms\n"
+		<< "  sweep + batch (" << GA::OBBBatch::SimdPath() << ") " << batchMs / frames << "ms\n"
+		<< "  mismatched frames " << mismatches << std::endl;
+
+	// more threads or the contact cache should only change the time, never which contacts come out
+	std::cout << "PhysicsLogic on " << std::thread::hardware_concurrency() << " hardware thread(s)\n";
+	CONTACT_LOG reference, contacts;
+	double ms = RunPhysics(boxes, frames, 1, false, reference);
+	std::cout << "  threads=1 cache=false " << ms << "ms\n";
+	for (unsigned threads : { 1u, 2u, 4u, 8u }) {
+		ms = RunPhysics(boxes, frames, threads, true, contacts);
+		bool same = (contacts == reference);
+		if (same == false)
+			++mismatches;
+		std::cout << "  threads=" << threads << " cache=true  " << ms << "ms" << (same ? "" : " contacts differ") << "\n";
+	}
+	std::cout.flush();
+	return (mismatches == 0) ? 0 : 1;
+}
@@ -0,0 +1,121 @@
+// Runs the same wave for a fixed number of ticks with [Systems] multithreaded off, then on,
+// the score and enemies left have to come out the same either way
+// usage: DeterminismTest [ticks]
+#include "../Source/Systems/PhysicsLogic.h"
+#include "../Source/Systems/BulletLogic.h"
+#include "../Source/Systems/EnemyLogic.h"
+#include "../Source/Entities/BulletPool.h"
+#include "../Source/Components/Identification.h"
+#include "../Source/Components/Gameplay.h"
+#include "../Source/Components/Components.h"
+
+namespace
+{
+	using namespace GA;
+
+	constexpr unsigned columns = 10, rows = 6;
+
+	struct RESULT { int score, enemyCount; };
+
+	// a grid of enemies high enough that the formation never reaches the shield line in a run
+	void AddWave(flecs::world& world)
+	{
+		for (unsigned i = 0; i < columns * rows; ++i) {
+			GW::MATH::GMATRIXF matrix = GW::MATH::GIdentityMatrixF;
+			matrix.row4.x = static_cast<float>(i % columns) * 8.0f;
+			matrix.row4.y = 150.0f + static_cast<float>(i / columns) * 8.0f;
+			GW::MATH::GOBBF box = {};
+			box.center = { matrix.row4.x, matrix.row4.y, 0, 0 };
+			box.extent = { 2, 2, 0, 0 };
+			box.rotation = GW::MATH::GIdentityQuaternionF;
+			world.entity()
+				.add<Enemy>()
+				.add<Collidable>()
+				.set<CollisionLayer>({ LAYER_ENEMY })
+				.set<Health>({ 30 })
+				.set<Position>({ { 0, 0 } })
+				.set<Orientation>({ GW::MATH2D::GIdentityMatrix2F })
+				.set<ModelTransform>({ matrix, 0 })
+				.set<ModelBoundary>({ box });
+		}
+		world.get_mut<GameState>()->enemyCount = columns * rows;
+	}
+
+	// fires one bullet up a column, a pooled bullet like the player's
+	void Fire(flecs::world& world, unsigned column)
+	{
+		flecs::entity bullet;
+		if (AcquireBullet(world, bullet) == false)
+			return;
+		GW::MATH::GMATRIXF matrix = GW::MATH::GIdentityMatrixF;
+		matrix.row4.x = static_cast<float>(column) * 8.0f;
+		matrix.row4.y = 20.0f;
+		bullet.set<ModelTransform>({ matrix, 0 });
+		GW::MATH::GOBBF box = {};
+		box.center = { matrix.row4.x, matrix.row4.y, 0, 0 };
+		box.extent = { 0.5f, 0.5f, 0, 0 };
+		box.rotation = GW::MATH::GIdentityQuaternionF;
+		bullet.set<ModelBoundary>({ box });
+	}
+
+	RESULT Run(unsigned ticks, bool multithreaded)
+	{
+		auto config = std::make_shared<GameConfig>();
+		(*config)["Systems"]["multithreaded"] = multithreaded;
+		(*config)["Physics"]["threads"] = multithreaded ? 4 : 1;
+		auto world = std::make_shared<flecs::world>();
+		world->set<GameState>({});
+		auto playEvents = std::make_shared<PlayEventQueue>();
+		// same order Application uses, so the systems run in the game's order
+		PhysicsLogic physics;
+		BulletLogic bullets;
+		EnemyLogic enemies;
+		physics.Init(world, config, nullptr);
+		bullets.Init(world, config, nullptr);
+		enemies.Init(world, config, playEvents, nullptr, {});
+		AddWave(*world);
+
+		flecs::entity prefab = world->prefab()
+			.add<Bullet>()
+			.add<Collidable>()
+			.set<CollisionLayer>({ LAYER_BULLET })
+			.set<Velocity>({ { 0, 60.0f } })
+			.set_override<Damage>({ 10 })
+			.set_override<Position>({ { 0, 0 } })
+			.set_override<Orientation>({ GW::MATH2D::GIdentityMatrix2F })
+			.set_override<ModelTransform>({ GW::MATH::GIdentityMatrixF, 0 })
+			.set_override<ModelBoundary>({});
+		FillBulletPool(*world, prefab, 64);
+
+		for (unsigned t = 0; t < ticks; ++t) {
+			// a fixed firing pattern, the formation moves under it so some shots miss
+			if (t % 4 == 0)
+				Fire(*world, (t / 4 * 7) % columns);
+			world->progress(1.0f / 60.0f);
+			playEvents->Dispatch();
+		}
+		const GameState* state = world->get<GameState>();
+		RESULT result = { state->score, state->enemyCount };
+		enemies.Shutdown();
+		bullets.Shutdown();
+		physics.Shutdown();
+		EmptyBulletPool();
+		return result;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	unsigned ticks = (argc > 1) ? static_cast<unsigned>(std::atoi(argv[1])) : 600;
+	RESULT single = Run(ticks, false);
+	RESULT multi = Run(ticks, true);
+	std::cout << ticks << " ticks\n"
+		<< "  multithreaded=false score " << single.score << ", enemies " << single.enemyCount << "\n"
+		<< "  multithreaded=true  score " << multi.score << ", enemies " << multi.enemyCount << std::endl;
+	// a run where nothing died would pass without testing anything
+	if (single.score == 0) {
+		std::cout << "no enemies destroyed, nothing compared" << std::endl;
+		return 1;
+	}
+	return (single.score == multi.score && single.enemyCount == multi.enemyCount) ? 0 : 1;
+}
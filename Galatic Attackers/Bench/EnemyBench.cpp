@@ -0,0 +1,98 @@
+// Times the Enemy System the game runs (query columns, iter) against the per-entity each() it replaced
+// usage: EnemyBench [enemies] [frames]
+#include "../Source/Systems/EnemyLogic.h"
+#include "../Source/Components/Identification.h"
+#include "../Source/Components/Gameplay.h"
+#include "../Source/Components/Visuals.h"
+
+namespace
+{
+	using namespace GA;
+
+	// the old Enemy System, matched on Enemy/Health/Position and looked the rest up per entity
+	// the branches that kick enemies or take lives never run here, same as a normal frame
+	void AddOldEnemySystem(flecs::world& world, std::atomic<bool>& shieldOn)
+	{
+		world.system<Enemy, Health, Position, const LevelEntities>("Old Enemy System")
+			.term_at(4).singleton()
+			.each([&world, &shieldOn](flecs::entity e, Enemy, Health& h, Position& p, const LevelEntities& level) {
+			if (world.get<GameState>()->pause)
+				return;
+			if (e.get<Health>()->value <= 0)
+				e.destruct();
+			ModelTransform* edit = e.get_mut<ModelTransform>();
+			if (shieldOn && edit->matrix.row4.y <= 60.0f) {
+				edit->matrix.row4.y += 500;
+				shieldOn = false;
+			}
+			if (edit->matrix.row4.y <= 30)
+				edit->matrix.row4.y += 500;
+			p.value = { 0, 0 };
+		});
+	}
+
+	// how many entities the system's query visits, both have to see every enemy for the times to compare
+	unsigned Matched(const flecs::system& system)
+	{
+		unsigned matched = 0;
+		system.query().iter([&matched](flecs::iter& it) { matched += static_cast<unsigned>(it.count()); });
+		return matched;
+	}
+
+	double Time(const flecs::system& system, unsigned frames)
+	{
+		auto start = std::chrono::steady_clock::now();
+		for (unsigned f = 0; f < frames; ++f)
+			system.run();
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+}
+
+int main(int argc, char** argv)
+{
+	unsigned count = (argc > 1) ? static_cast<unsigned>(std::atoi(argv[1])) : 10000;
+	unsigned frames = (argc > 2) ? static_cast<unsigned>(std::atoi(argv[2])) : 200;
+	auto config = std::make_shared<GameConfig>();
+	auto world = std::make_shared<flecs::world>();
+	world->set<GameState>({});
+	// enemies are spread over one prefab per enemy model like the level, so there are several tables
+	flecs::entity prefabs[15];
+	for (unsigned i = 0; i < 15; ++i)
+		prefabs[i] = world->prefab().set<Material>({ 1.0f, 0.0f, 0.0f });
+	for (unsigned i = 0; i < count; ++i) {
+		GW::MATH::GMATRIXF matrix = GW::MATH::GIdentityMatrixF;
+		matrix.row4.x = static_cast<float>(i % 100);
+		matrix.row4.y = 100.0f + static_cast<float>(i / 100) * 0.01f; // above the shield line
+		world->entity().is_a(prefabs[i % 15])
+			.add<Enemy>()
+			.set<Health>({ 30 })
+			.set<Position>({ { 0, 0 } })
+			.set<ModelTransform>({ matrix, 0 })
+			.set<FormationSlot>({ matrix });
+	}
+
+	std::atomic<bool> shieldOn{ true };
+	AddOldEnemySystem(*world, shieldOn);
+	GA::EnemyLogic enemies;
+	enemies.Init(world, config, std::make_shared<PlayEventQueue>(), nullptr, {});
+	flecs::system oldSystem = world->system(world->lookup("Old Enemy System"));
+	flecs::system newSystem = world->system(world->lookup("Enemy System"));
+	if (Matched(oldSystem) != count || Matched(newSystem) != count) {
+		std::cout << "each matched " << Matched(oldSystem) << ", iter matched " << Matched(newSystem)
+			<< " of " << count << " enemies" << std::endl;
+		return 1;
+	}
+	// once each first so neither pays for building its table cache
+	oldSystem.run();
+	newSystem.run();
+	double oldMs = Time(oldSystem, frames);
+	double newMs = Time(newSystem, frames);
+	std::cout << count << " enemies, " << frames << " frames\n"
+		<< "  each (per-entity lookups) " << oldMs / frames << "ms, "
+		<< oldMs * 1e6 / (double(frames) * count) << "ns per enemy\n"
+		<< "  iter (query columns)      " << newMs / frames << "ms, "
+		<< newMs * 1e6 / (double(frames) * count) << "ns per enemy\n"
+		<< "  speedup " << oldMs / newMs << "x" << std::endl;
+	enemies.Shutdown();
+	return 0;
+}
@@ -0,0 +1,24 @@
+// Same libraries as Source/Precompiled.h, minus anything that needs a window, GPU or sound card
+// Lets the benches link the game's own systems on a build machine with no Vulkan installed
+#define GATEWARE_ENABLE_CORE // All libraries need this
+#define GATEWARE_ENABLE_SYSTEM // Many libs require system level libraries
+#define GATEWARE_ENABLE_MATH // Enables all 3D Math Libraries
+#define GATEWARE_ENABLE_MATH2D // Enables all 2D Math Libraries
+#define GATEWARE_ENABLE_AUDIO // Enables all Audio Libraries
+// Stub out everything that talks to hardware, the types still exist so game code compiles
+#define GATEWARE_DISABLE_GWINDOW // no X11, there is nothing to draw to
+#define GATEWARE_DISABLE_GAUDIO
+#define GATEWARE_DISABLE_GAUDIO3D
+#define GATEWARE_DISABLE_GSOUND
+#define GATEWARE_DISABLE_GSOUND3D
+#define GATEWARE_DISABLE_GMUSIC
+#define GATEWARE_DISABLE_GMUSIC3D
+#include "../gateware-main/Gateware.h"
+// load_data_oriented.h calls std::fabsf, which MSVC has but libstdc++ doesn't
+#include <cmath>
+#if !defined(_MSC_VER)
+namespace std { using ::fabsf; }
+#endif
+#include "../flecs-3.1.4/flecs.h"
+#include "../inifile-cpp-master/include/inicpp.h"
+#include "../Source/load_data_oriented.h"
@@ -2,6 +2,9 @@
 #include "Components\Identification.h"
 #include "Components\Visuals.h"
 #include "Components\Components.h"
+#include "Components\Gameplay.h"
+#include "Utils\Random.h"
+#include "Utils\Log.h"
 // open some Gateware namespaces for conveinence 
 // NEVER do this in a header file!
 using namespace GW;
@@ -12,23 +15,29 @@ using namespace GA;
 
 bool Application::Init()
 {
-	eventPusher.Create();
 
 	// load all game settigns
 	gameConfig = std::make_shared<GameConfig>(); 
+	// log messages below this level are dropped before any of their text is put together
+	std::string logLevelName = gameConfig->at("Logging").at("level").as<std::string>();
+	GA::LOG_LEVEL logLevel = GA::Logger::Default_Level;
+	bool knownLogLevel = GA::Logger::ParseLevel(logLevelName, logLevel);
+	GA::Logger::Configure(logLevel, gameConfig->at("Logging").at("ring").as<unsigned int>());
+	// a typo shouldn't quietly turn off errors too
+	if (!knownLogLevel)
+		std::cout << "[Logging] unknown level \"" << logLevelName << "\", using "
+			<< GA::Logger::Category(logLevel) << std::endl;
 	// create the ECS system
 	game = std::make_shared<flecs::world>(); 
 	levelData = std::make_shared<Level_Data>();
+	// parsed models kept between levels, given in MB
+	levelData->SetModelCacheBudget(
+		static_cast<size_t>(G_LARGER(0, gameConfig->at("ModelCache").at("budget").as<int>())) << 20);
+	playEvents = std::make_shared<PlayEventQueue>();
 	currentLevel = std::make_shared<int>();
-	enemyCount = std::make_shared<int>();
 	levelChange = std::make_shared<bool>();
-	youLose = std::make_shared<bool>();
-	youWin = std::make_shared<bool>();
-	pause = std::make_shared<bool>();
-	score = std::make_shared<int>();
-	*youLose = false;
-	*youWin = false;
-	*pause = false;
+	// score, enemy count, pause and win/lose live here so any thread can update them
+	game->add<GameState>();
 	ispaused = false;
 	*(currentLevel) = 1;
 	LoadLevel(*currentLevel);
@@ -136,6 +145,8 @@ bool Application::Shutdown()
 		return false;
 	if (enemySystem.Shutdown() == false)
 		return false;
+	// whatever the in memory log still holds (nothing when [Logging] ring is 0)
+	GA::Logger::DumpRing(std::cout);
 
 	return true;
 }
@@ -200,19 +211,24 @@ bool Application::InitEntities()
 
 bool Application::InitSystems()
 {
+	// every system's random numbers start from this, printed so a session can be replayed with it
+	uint64_t seed = GA::Random::SeedAll(gameConfig->at("Random").at("seed").as<unsigned int>());
+	std::cout << "[Random] seed " << seed << std::endl;
+	tickStep = 1.0 / G_LARGER(1, gameConfig->at("Simulation").at("tickrate").as<int>());
+	maxTicks = G_LARGER(1, gameConfig->at("Simulation").at("maxticks").as<int>());
 	// connect systems to global ECS
 	if (playerSystem.Init(	game, gameConfig, immediateInput, bufferedInput, 
-							gamePads, audioEngine, eventPusher, levelData, currentLevel, levelChange, youWin,youLose, pause, enemyCount) == false)
+							gamePads, audioEngine, playEvents, levelData, currentLevel, levelChange) == false)
 		return false;
 	if (levelSystem.Init(game, gameConfig, audioEngine, levelData) == false)
 		return false;
-	if (d3dRenderingSystem.Init(game, gameConfig, d3d11, window, levelData, levelChange, youWin, youLose, entityVec, currentLevel, score) == false)
+	if (d3dRenderingSystem.Init(game, gameConfig, d3d11, window, levelData, levelChange, entityVec, currentLevel) == false)
 		return false;
 	if (physicsSystem.Init(game, gameConfig, levelData) == false)
 		return false;
 	if (bulletSystem.Init(game, gameConfig, levelData) == false)
 		return false;
-	if (enemySystem.Init(game, gameConfig, eventPusher, levelData, pause, entityVec, youWin, enemyCount, score) == false)
+	if (enemySystem.Init(game, gameConfig, playEvents, levelData, entityVec) == false)
 		return false;
 
 	return true;
@@ -220,7 +236,7 @@ bool Application::InitSystems()
 
 bool Application::GameLoop()
 {
-	// compute delta time and pass to the ECS system
+	// compute delta time, the ECS is fed it in fixed size steps
 	static auto start = std::chrono::steady_clock::now();
 	double elapsed = std::chrono::duration<double>(
 		std::chrono::steady_clock::now() - start).count();
@@ -230,19 +246,32 @@ bool Application::GameLoop()
 	immediateInput.GetState(G_KEY_ENTER, in);
 	if (in == 1)
 	{
-		if (*pause && ispaused == false)
+		GameState* state = game->get_mut<GameState>();
+		if (state->pause && ispaused == false)
 		{
-			*pause = false;
+			state->pause = false;
 			ispaused = true;
 		}
 		else
 		{
-			*pause = true;
+			state->pause = true;
 			ispaused = false;
 		}
 	}
 
-	return game->progress(static_cast<float>(elapsed)); 
+	// a hitch becomes several normal ticks instead of one big one, past maxTicks the sim slows down
+	// rather than taking ever longer frames to catch up
+	accumulator = G_SMALLER(accumulator + elapsed, tickStep * maxTicks);
+	bool running = true;
+	while (running && accumulator >= tickStep) {
+		running = game->progress(static_cast<float>(tickStep));
+		// handlers see every event from the tick in one batch
+		playEvents->Dispatch();
+		accumulator -= tickStep;
+	}
+	// draw once, blended by how far real time has got towards the next tick
+	d3dRenderingSystem.Render(static_cast<float>(accumulator / tickStep));
+	return running;
 }
 
 void Application::LoadLevel(int currentLevel)
@@ -271,6 +300,8 @@ void Application::LoadLevel(int currentLevel)
 	levelData->LoadLevel(level.c_str(), models.c_str(), log);
 
 	UpdateLevelData();
+	// resolve named entities once so systems don't have to every frame
+	game->set<LevelEntities>(LevelEntities::Find(*game));
 
 }
 
@@ -38,12 +38,7 @@ class Application
 	std::shared_ptr<GameConfig> gameConfig; // .ini file game settings
 	std::shared_ptr<Level_Data> levelData;
 	std::shared_ptr<int> currentLevel;
-	std::shared_ptr<int> enemyCount;
-	std::shared_ptr<int> score;
 	std::shared_ptr<bool> levelChange;
-	std::shared_ptr<bool> youWin;
-	std::shared_ptr<bool> youLose;
-	std::shared_ptr<bool> pause;
 	bool ispaused;
 	std::vector<flecs::entity> entityVec;
 	std::string level;
@@ -59,8 +54,12 @@ class Application
 	GA::PhysicsLogic physicsSystem;
 	GA::BulletLogic bulletSystem;
 	GA::EnemyLogic enemySystem;
-	// EventGenerator for Game Events
-	GW::CORE::GEventGenerator eventPusher;
+	// gameplay events, batched and dispatched after each sim tick
+	std::shared_ptr<GA::PlayEventQueue> playEvents;
+	// the sim always advances in steps of tickStep seconds, real time piles up in accumulator
+	double tickStep = 1.0 / 60.0;
+	double accumulator = 0;
+	unsigned maxTicks = 5; // most ticks one frame may run before the sim is allowed to fall behind
 
 public:
 	bool Init();
@@ -24,9 +24,16 @@ namespace GA
 	struct RenderingSystem {};
 	struct BulletTest {};
 	struct Enable{};
-	struct TimesMoved { int timesMoved = 0; };
-	struct Movement { bool moveRight = true; };
-	struct Location { float location = 0; };
+	// marching state shared by every enemy in the wave (world singleton)
+	struct Formation {
+		GW::MATH::GVECTORF offset = { 0, 0, 0, 0 }; // added to each member's local transform
+		float stepX = 0.75f, dropY = 3.0f;
+		int stepsPerRow = 28, timesMoved = 0;
+		bool moveRight = true;
+		bool stepped = false; // offset changed this frame
+	};
+	// member transform relative to the formation, before the offset is applied
+	struct FormationSlot { GW::MATH::GMATRIXF local; };
 	//struct Material { float red, greem, blue; };
 }
 #endif
\ No newline at end of file
@@ -16,6 +16,21 @@ namespace GA
 
 	// powerups
 	struct ChargedShot { int max_destroy; };
+
+	// progress shared by every system (world singleton)
+	// atomic so systems running on worker threads can update it without locks
+	struct GameState {
+		std::atomic<int> score{ 0 }, enemyCount{ 0 };
+		std::atomic<bool> pause{ false }, youWin{ false }, youLose{ false };
+		GameState() = default;
+		// flecs copies components around, std::atomic can't be copied directly
+		GameState(const GameState& other) { *this = other; }
+		GameState& operator=(const GameState& other) {
+			score = other.score.load(); enemyCount = other.enemyCount.load();
+			pause = other.pause.load(); youWin = other.youWin.load(); youLose = other.youLose.load();
+			return *this;
+		}
+	};
 };
 
 #endif
\ No newline at end of file
@@ -13,6 +13,21 @@ namespace GA
 	struct ControllerID {
 		unsigned index = 0;
 	};
+	// Named level objects resolved once when the level's entities are made, lives on the world
+	// as a singleton so systems never look names up per frame. Reset when the level switches.
+	struct LevelEntities {
+		flecs::entity player, shield;
+		flecs::entity lives[3]; // "life 1" to "life 3", lost in that order
+		static LevelEntities Find(const flecs::world& world) {
+			LevelEntities found;
+			found.player = world.lookup("Player");
+			found.shield = world.lookup("shield");
+			found.lives[0] = world.lookup("life 1");
+			found.lives[1] = world.lookup("life 2");
+			found.lives[2] = world.lookup("life 3");
+			return found;
+		}
+	};
 };
 
 #endif
\ No newline at end of file
@@ -14,9 +14,46 @@ namespace GA
 
 	// Individual TAGs
 	struct Collidable {}; 
+
+	// Which group a collidable belongs to, [CollisionLayers] in the config decides which groups
+	// get tested against each other. Collidables without one are treated as level geometry.
+	enum COLLISION_LAYER { LAYER_GEOMETRY, LAYER_PLAYER, LAYER_SHIELD, LAYER_ENEMY, LAYER_BULLET, LAYER_COUNT };
+	struct CollisionLayer { unsigned value = LAYER_GEOMETRY; };
 	
-	// ECS Relationship tags
-	struct CollidedWith {};
+	// One slice of the collision pairs, a multi threaded system hands each worker thread one of these
+	struct CollisionWorker { unsigned slice; };
+
+	// Every pair of colliders touching this frame, lives on the world as a singleton.
+	// Replaces the old CollidedWith relationship, adding one of those per hit moved
+	// both entities into a new table (archetype) every time something got shot.
+	struct Contacts {
+		struct PAIR { flecs::entity a, b; };
+		std::vector<PAIR> pairs; // cleared & refilled by "Detect-Collisions" each frame
+		// relationship adds (each one a table move) the buffer avoided this frame
+		unsigned tableMovesSaved = 0;
+		// both sides of every pair sorted by entity, so looking one up doesn't scan every contact
+		struct TOUCH { flecs::entity_t self; flecs::entity other; };
+		std::vector<TOUCH> byEntity;
+		// rebuilds byEntity from pairs, "Detect-Collisions" calls it once after publishing them
+		void Index() {
+			byEntity.clear();
+			for (const PAIR& p : pairs) {
+				byEntity.push_back({ p.a.id(), p.b });
+				byEntity.push_back({ p.b.id(), p.a });
+			}
+			// stable keeps each entity's contacts in the order they appear in pairs
+			std::stable_sort(byEntity.begin(), byEntity.end(),
+				[](const TOUCH& x, const TOUCH& y) { return x.self < y.self; });
+		}
+		// calls func(other) for everything touching e this frame (like e.each<CollidedWith>)
+		template<typename Func>
+		void each(flecs::entity e, Func&& func) const {
+			auto first = std::lower_bound(byEntity.begin(), byEntity.end(), e.id(),
+				[](const TOUCH& t, flecs::entity_t id) { return t.self < id; });
+			for (; first != byEntity.end() && first->self == e.id(); ++first)
+				func(first->other);
+		}
+	};
 };
 
 #endif
\ No newline at end of file
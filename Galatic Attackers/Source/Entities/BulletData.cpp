@@ -3,6 +3,7 @@
 #include "../Components/Visuals.h"
 #include "../Components/Physics.h"
 #include "Prefabs.h"
+#include "BulletPool.h"
 #include "../Components/Gameplay.h"
 #include "../Components/Components.h"
 
@@ -26,6 +27,7 @@ bool GA::BulletData::Load(	std::shared_ptr<flecs::world> _game,
 	float yscale = (*readCfg).at("Lazers").at("yscale").as<float>();
 	int dmg = (*readCfg).at("Lazers").at("damage").as<int>();
 	int pcount = (*readCfg).at("Lazers").at("projectiles").as<int>();
+	int poolSize = (*readCfg).at("Lazers").at("pool").as<int>();
 	float frate = (*readCfg).at("Lazers").at("firerate").as<float>();
 	std::string fireFX = (*readCfg).at("Lazers").at("fireFX").as<std::string>();
 
@@ -44,6 +46,7 @@ bool GA::BulletData::Load(	std::shared_ptr<flecs::world> _game,
 		.set<Orientation>({ world })
 		.set<Acceleration>({ 0, 0 })
 		.set<Velocity>({ 0, speed })
+		.set<CollisionLayer>({ LAYER_BULLET })
 		.set_override<ModelTransform>(*_game->lookup("Crystal3").get_mut<ModelTransform>())
 		.set_override<ModelBoundary>(*_game->lookup("Crystal3").get_mut<ModelBoundary>())
 		.set<GW::AUDIO::GSound>(shoot.Relinquish())
@@ -60,13 +63,22 @@ bool GA::BulletData::Load(	std::shared_ptr<flecs::world> _game,
 	// register this prefab by name so other systems can use it
 	RegisterPrefab("Lazer Bullet", lazerPrefab);
 	RegisterPrefab("Death", deathPrefab);
+	// bullets are recycled, make enough up front that firing never creates entities
+	FillBulletPool(*_game, lazerPrefab, static_cast<unsigned>(G_LARGER(poolSize, 0)));
 
 	return true;
 }
 
 bool GA::BulletData::Unload(std::shared_ptr<flecs::world> _game)
 {
+	// report how much of the pool actually got used
+	BULLET_POOL_STATS stats = BulletPoolStats();
+	std::cout << "[Bullets] pool size " << stats.size << ", most in use " << stats.highWater;
+	if (stats.grows > 0)
+		std::cout << ", ran out " << stats.grows << " time(s), consider [Lazers] pool=" << stats.highWater;
+	std::cout << std::endl;
 	// remove all bullets and their prefabs
+	EmptyBulletPool(); // disabled bullets don't show up in the loop below
 	_game->defer_begin(); // required when removing while iterating!
 	_game->each([](flecs::entity e, Bullet&) {
 		e.destruct(); // destroy this entitiy (happens at frame end)
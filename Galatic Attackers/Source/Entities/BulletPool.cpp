@@ -0,0 +1,101 @@
+#include "BulletPool.h"
+#include "../Components/Physics.h"
+
+// bullets are disabled rather than destroyed, this keeps entity ids and table rows from
+// being churned every shot. Disabled entities are skipped by every query/system.
+namespace
+{
+	flecs::entity poolPrefab;
+	std::vector<flecs::entity> bullets; // every pooled bullet, index is its slot
+	std::vector<unsigned char> inUse; // 1 if the slot is flying
+	std::vector<unsigned> freeSlots; // slots waiting to be fired
+	std::unordered_map<flecs::entity_t, unsigned> slots; // entity to slot
+	unsigned highWater = 0;
+	unsigned grows = 0; // times firing found the pool empty
+
+	void AddBullet(flecs::world& stage)
+	{
+		flecs::entity bullet = stage.entity().is_a(poolPrefab);
+		bullet.disable();
+		slots[bullet.id()] = static_cast<unsigned>(bullets.size());
+		freeSlots.push_back(static_cast<unsigned>(bullets.size()));
+		bullets.push_back(bullet);
+		inUse.push_back(0);
+	}
+	// adds count bullets at once, the new slots are fired lowest first
+	void AddBullets(flecs::world& stage, unsigned count)
+	{
+		for (unsigned i = 0; i < count; ++i)
+			AddBullet(stage);
+		std::reverse(freeSlots.end() - count, freeSlots.end());
+	}
+}
+// functions defined in this file have access to the data in the nameless namespace above
+namespace GA
+{
+	bool FillBulletPool(flecs::world& world, const flecs::entity prefab, unsigned count)
+	{
+		EmptyBulletPool();
+		poolPrefab = prefab;
+		bullets.reserve(count);
+		inUse.reserve(count);
+		freeSlots.reserve(count);
+		AddBullets(world, count);
+		return true;
+	}
+	bool AcquireBullet(flecs::world& stage, flecs::entity& outBullet)
+	{
+		if (poolPrefab.is_valid() == false)
+			return false; // pool was never filled
+		// ran dry, grow by half again (at least 8) so a burst doesn't grow it every shot
+		// BulletData::Unload reports how big it got
+		if (freeSlots.empty()) {
+			AddBullets(stage, G_LARGER(static_cast<unsigned>(bullets.size()) / 2, 8u));
+			++grows;
+		}
+		unsigned slot = freeSlots.back();
+		freeSlots.pop_back();
+		inUse[slot] = 1;
+		unsigned flying = static_cast<unsigned>(bullets.size() - freeSlots.size());
+		highWater = G_LARGER(highWater, flying);
+		// operations must go through the stage we were called from
+		outBullet = bullets[slot].mut(stage);
+		outBullet.enable();
+		return true;
+	}
+	bool ReleaseBullet(flecs::entity bullet)
+	{
+		auto iter = slots.find(bullet.id());
+		if (iter == slots.end()) {
+			bullet.destruct(); // not one of ours
+			return true;
+		}
+		if (inUse[iter->second] == 0)
+			return false; // already waiting
+		inUse[iter->second] = 0;
+		freeSlots.push_back(iter->second);
+		// reset it so nothing from this shot leaks into the next one
+		bullet.set<Position>({ 0, 0 });
+		bullet.disable();
+		return true;
+	}
+	bool EmptyBulletPool()
+	{
+		for (auto& bullet : bullets) {
+			if (bullet.is_alive())
+				bullet.destruct();
+		}
+		bullets.clear();
+		inUse.clear();
+		freeSlots.clear();
+		slots.clear();
+		highWater = 0;
+		grows = 0;
+		return true;
+	}
+	BULLET_POOL_STATS BulletPoolStats()
+	{
+		unsigned size = static_cast<unsigned>(bullets.size());
+		return { size, size - static_cast<unsigned>(freeSlots.size()), highWater, grows };
+	}
+}
@@ -0,0 +1,27 @@
+// uses a nameless namespace to keep bullets around for reuse instead of destroying them
+#ifndef BULLETPOOL_H
+#define BULLETPOOL_H
+
+// example space game (avoid name collisions)
+namespace GA
+{
+	// usage numbers so the pool size can be tuned ([Lazers] pool in the config)
+	struct BULLET_POOL_STATS {
+		unsigned size; // bullets that exist (in use or waiting)
+		unsigned inUse; // bullets currently flying
+		unsigned highWater; // most bullets ever in use at once
+		unsigned grows; // times the pool ran out while firing
+	};
+	// creates count disabled bullets from the prefab up front
+	bool FillBulletPool(flecs::world& world, const flecs::entity prefab, unsigned count);
+	// enables a waiting bullet, if none are left the pool grows by a chunk
+	bool AcquireBullet(flecs::world& stage, flecs::entity& outBullet);
+	// disables a pooled bullet so it can be fired again, anything else is destroyed like before
+	// returns false if the bullet was already released
+	bool ReleaseBullet(flecs::entity bullet);
+	// destroys every pooled bullet (in use or not)
+	bool EmptyBulletPool();
+	BULLET_POOL_STATS BulletPoolStats();
+}
+
+#endif
@@ -6,6 +6,30 @@
 #include "../Components/Gameplay.h"
 #include "../Components/Components.h"
 
+namespace
+{
+	// every enemy type is set up the same way, only the level model it comes from differs
+	flecs::entity EnemyPrefab(flecs::world& game, const char* name, const GA::Material& material,
+		const GW::MATH2D::GMATRIX2F& orientation, int health)
+	{
+		using namespace GA;
+		return game.prefab(name)
+			// .set<> in a prefab means components are shared (instanced)
+			.set<Material>(material)
+			.set<Orientation>({ orientation })
+			// .override<> ensures a component is unique to each entity created from a prefab
+			.set_override<Health>({ health })
+			.override<Acceleration>()
+			.override<Velocity>()
+			.override<Position>()
+			.override<ModelTransform>() // each enemy marches on its own copy of the level transform
+			.override<ModelBoundary>()
+			.override<Enemy>() // Tag this prefab as an enemy (for queries/systems)
+			.set<CollisionLayer>({ LAYER_ENEMY }) // decides what it gets tested against
+			.override<Collidable>(); // can be collided with
+	}
+}
+
 bool GA::EnemyData::Load(std::shared_ptr<flecs::world> _game,
 	std::weak_ptr<const GameConfig> _gameConfig,
 	GW::AUDIO::GAudio _audioEngine,
@@ -32,184 +56,29 @@ bool GA::EnemyData::Load(std::shared_ptr<flecs::world> _game,
 	GW::MATH2D::GMatrix2D::Scale2F(world,
 		GW::MATH2D::GVECTOR2F{ xscale, yscale }, world);
 
-	// add prefab to ECS
-	auto enemyPrefab = _game->prefab("Spaceship5")
-		 //.set<> in a prefab means components are shared (instanced)
-		.set<Material>({ red, green, blue })
-		.set<Orientation>({ world })
-		.set<ModelBoundary*>(_game->prefab("Spaceship5").get_mut<ModelBoundary>())
-		// .override<> ensures a component is unique to each entity created from a prefab
-		.set_override<Health>({ health })
-		.override<Acceleration>()
-		.override<Velocity>()
-		.override<Position>()
-		.override<Enemy>() // Tag this prefab as an enemy (for queries/systems)
-		.override<Collidable>(); // can be collided with
-
-	auto enemyPrefab1 = _game->prefab("Spaceship5.001")
-		// .set<> in a prefab means components are shared (instanced)
-		.set<Material>({ red, green, blue })
-		.set<Orientation>({ world })
-		//.override<> ensures a component is unique to each entity created from a prefab
-		.set_override<Health>({ health })
-		.override<Acceleration>()
-		.override<Velocity>()
-		.override<Position>()
-		.override<Enemy>() // Tag this prefab as an enemy (for queries/systems)
-		.override<Collidable>(); // can be collided with
-	auto enemyPrefab2 = _game->prefab("Spaceship5.002")
-		// .set<> in a prefab means components are shared (instanced)
-		.set<Material>({ red, green, blue })
-		.set<Orientation>({ world })
-		// .override<> ensures a component is unique to each entity created from a prefab
-		.set_override<Health>({ health })
-		.override<Acceleration>()
-		.override<Velocity>()
-		.override<Position>()
-		.override<Enemy>() // Tag this prefab as an enemy (for queries/systems)
-		.override<Collidable>(); // can be collided with
-
-	auto enemyPrefab3 = _game->prefab("Spaceship5.003")
-		// .set<> in a prefab means components are shared (instanced)
-		.set<Material>({ red, green, blue })
-		.set<Orientation>({ world })
-		// .override<> ensures a component is unique to each entity created from a prefab
-		.set_override<Health>({ health })
-		.override<Acceleration>()
-		.override<Velocity>()
-		.override<Position>()
-		.override<Enemy>() // Tag this prefab as an enemy (for queries/systems)
-		.override<Collidable>(); // can be collided with
-
-	auto enemyPrefab4 = _game->prefab("Spaceship5.004")
-		// .set<> in a prefab means components are shared (instanced)
-		.set<Material>({ red, green, blue })
-		.set<Orientation>({ world })
-		// .override<> ensures a component is unique to each entity created from a prefab
-		.set_override<Health>({ health })
-		.override<Acceleration>()
-		.override<Velocity>()
-		.override<Position>()
-		.override<Enemy>() // Tag this prefab as an enemy (for queries/systems)
-		.override<Collidable>(); // can be collided with
-
-	auto enemyPrefab5 = _game->prefab("Spaceship5.005")
-		// .set<> in a prefab means components are shared (instanced)
-		.set<Material>({ red, green, blue })
-		.set<Orientation>({ world })
-		// .override<> ensures a component is unique to each entity created from a prefab
-		.set_override<Health>({ health })
-		.override<Acceleration>()
-		.override<Velocity>()
-		.override<Position>()
-		.override<Enemy>() // Tag this prefab as an enemy (for queries/systems)
-		.override<Collidable>(); // can be collided with
-
-	auto enemyPrefab6 = _game->prefab("Spaceship5.006")
-		// .set<> in a prefab means components are shared (instanced)
-		.set<Material>({ red, green, blue })
-		.set<Orientation>({ world })
-		// .override<> ensures a component is unique to each entity created from a prefab
-		.set_override<Health>({ health })
-		.override<Acceleration>()
-		.override<Velocity>()
-		.override<Position>()
-		.override<Enemy>() // Tag this prefab as an enemy (for queries/systems)
-		.override<Collidable>(); // can be collided with
-
-	auto enemyPrefab7 = _game->prefab("Spaceship5.007")
-		// .set<> in a prefab means components are shared (instanced)
-		.set<Material>({ red, green, blue })
-		.set<Orientation>({ world })
-		// .override<> ensures a component is unique to each entity created from a prefab
-		.set_override<Health>({ health })
-		.override<Acceleration>()
-		.override<Velocity>()
-		.override<Position>()
-		.override<Enemy>() // Tag this prefab as an enemy (for queries/systems)
-		.override<Collidable>(); // can be collided with
-
-	auto enemyPrefab8 = _game->prefab("Spaceship5.008")
-		//.set<> in a prefab means components are shared (instanced)
-		.set<Material>({ red, green, blue })
-		.set<Orientation>({ world })
-		//.override<> ensures a component is unique to each entity created from a prefab
-		.set_override<Health>({ health })
-		.override<Acceleration>()
-		.override<Velocity>()
-		.override<Position>()
-		.override<Enemy>() // Tag this prefab as an enemy (for queries/systems)
-		.override<Collidable>(); // can be collided with
-	auto enemyPrefab9 = _game->prefab("Spaceship5.009")
-		//.set<> in a prefab means components are shared (instanced)
-		.set<Material>({ red, green, blue })
-		.set<Orientation>({ world })
-		//.override<> ensures a component is unique to each entity created from a prefab
-		.set_override<Health>({ health })
-		.override<Acceleration>()
-		.override<Velocity>()
-		.override<Position>()
-		.override<Enemy>() // Tag this prefab as an enemy (for queries/systems)
-		.override<Collidable>(); // can be collided with
-	auto enemyPrefab10 = _game->prefab("Spaceship5.010")
-		//.set<> in a prefab means components are shared (instanced)
-		.set<Material>({ red, green, blue })
-		.set<Orientation>({ world })
-		//.override<> ensures a component is unique to each entity created from a prefab
-		.set_override<Health>({ health })
-		.override<Acceleration>()
-		.override<Velocity>()
-		.override<Position>()
-		.override<Enemy>() // Tag this prefab as an enemy (for queries/systems)
-		.override<Collidable>(); // can be collided with
-	auto enemyPrefab11 = _game->prefab("Spaceship5.011")
-		//.set<> in a prefab means components are shared (instanced)
-		.set<Material>({ red, green, blue })
-		.set<Orientation>({ world })
-		//.override<> ensures a component is unique to each entity created from a prefab
-		.set_override<Health>({ health })
-		.override<Acceleration>()
-		.override<Velocity>()
-		.override<Position>()
-		.override<Enemy>() // Tag this prefab as an enemy (for queries/systems)
-		.override<Collidable>(); // can be collided with
-	auto enemyPrefab12 = _game->prefab("Spaceship5.012")
-		//.set<> in a prefab means components are shared (instanced)
-		.set<Material>({ red, green, blue })
-		.set<Orientation>({ world })
-		//.override<> ensures a component is unique to each entity created from a prefab
-		.set_override<Health>({ health })
-		.override<Acceleration>()
-		.override<Velocity>()
-		.override<Position>()
-		.override<Enemy>() // Tag this prefab as an enemy (for queries/systems)
-		.override<Collidable>(); // can be collided with
-	auto enemyPrefab13 = _game->prefab("Spaceship5.013")
-		//.set<> in a prefab means components are shared (instanced)
-		.set<Material>({ red, green, blue })
-		.set<Orientation>({ world })
-		//.override<> ensures a component is unique to each entity created from a prefab
-		.set_override<Health>({ health })
-		.override<Acceleration>()
-		.override<Velocity>()
-		.override<Position>()
-		.override<Enemy>() // Tag this prefab as an enemy (for queries/systems)
-		.override<Collidable>(); // can be collided with
-	auto enemyPrefab14 = _game->prefab("Spaceship5.014")
-		//.set<> in a prefab means components are shared (instanced)
-		.set<Material>({ red, green, blue })
-		.set<Orientation>({ world })
-		//.override<> ensures a component is unique to each entity created from a prefab
-		.set_override<Health>({ health })
-		.override<Acceleration>()
-		.override<Velocity>()
-		.override<Position>()
-		.override<Enemy>() // Tag this prefab as an enemy (for queries/systems)
-		.override<Collidable>(); // can be collided with
+	// add prefabs to ECS, one per enemy model in the level
+	Material material = { red, green, blue };
+	auto enemyPrefab = EnemyPrefab(*_game, "Spaceship5", material, world, health)
+		.set<ModelBoundary*>(_game->prefab("Spaceship5").get_mut<ModelBoundary>());
+	auto enemyPrefab1 = EnemyPrefab(*_game, "Spaceship5.001", material, world, health);
+	auto enemyPrefab2 = EnemyPrefab(*_game, "Spaceship5.002", material, world, health);
+	auto enemyPrefab3 = EnemyPrefab(*_game, "Spaceship5.003", material, world, health);
+	auto enemyPrefab4 = EnemyPrefab(*_game, "Spaceship5.004", material, world, health);
+	auto enemyPrefab5 = EnemyPrefab(*_game, "Spaceship5.005", material, world, health);
+	auto enemyPrefab6 = EnemyPrefab(*_game, "Spaceship5.006", material, world, health);
+	auto enemyPrefab7 = EnemyPrefab(*_game, "Spaceship5.007", material, world, health);
+	auto enemyPrefab8 = EnemyPrefab(*_game, "Spaceship5.008", material, world, health);
+	auto enemyPrefab9 = EnemyPrefab(*_game, "Spaceship5.009", material, world, health);
+	auto enemyPrefab10 = EnemyPrefab(*_game, "Spaceship5.010", material, world, health);
+	auto enemyPrefab11 = EnemyPrefab(*_game, "Spaceship5.011", material, world, health);
+	auto enemyPrefab12 = EnemyPrefab(*_game, "Spaceship5.012", material, world, health);
+	auto enemyPrefab13 = EnemyPrefab(*_game, "Spaceship5.013", material, world, health);
+	auto enemyPrefab14 = EnemyPrefab(*_game, "Spaceship5.014", material, world, health);
 
 	auto enemy1 = _game->lookup("Spaceship5.014");
 	if (enemy1.is_valid()) {
 		enemy1.override<Enemy>();
+		enemy1.set<CollisionLayer>({ LAYER_ENEMY });
 		enemy1.set_override<Health>({ health });
 		enemy1.add<Orientation>();
 		enemy1.add<Position>();
@@ -218,6 +87,7 @@ bool GA::EnemyData::Load(std::shared_ptr<flecs::world> _game,
 	auto enemy2 = _game->lookup("Spaceship5.013");
 	if (enemy2.is_valid()) {
 		enemy2.override<Enemy>();
+		enemy2.set<CollisionLayer>({ LAYER_ENEMY });
 		enemy2.set_override<Health>({ health });
 		enemy2.add<Orientation>();
 		enemy2.add<Position>();
@@ -226,6 +96,7 @@ bool GA::EnemyData::Load(std::shared_ptr<flecs::world> _game,
 	auto enemy3 = _game->lookup("Spaceship5.012");
 	if (enemy3.is_valid()) {
 		enemy3.override<Enemy>();
+		enemy3.set<CollisionLayer>({ LAYER_ENEMY });
 		enemy3.set_override<Health>({ health });
 		enemy3.add<Orientation>();
 		enemy3.add<Position>();
@@ -234,6 +105,7 @@ bool GA::EnemyData::Load(std::shared_ptr<flecs::world> _game,
 	auto enemy4 = _game->lookup("Spaceship5.011");
 	if (enemy4.is_valid()) {
 		enemy4.override<Enemy>();
+		enemy4.set<CollisionLayer>({ LAYER_ENEMY });
 		enemy4.set_override<Health>({ health });
 		enemy4.add<Orientation>();
 		enemy4.add<Position>();
@@ -242,6 +114,7 @@ bool GA::EnemyData::Load(std::shared_ptr<flecs::world> _game,
 	auto enemy5 = _game->lookup("Spaceship5.0010");
 	if (enemy5.is_valid()) {
 		enemy5.override<Enemy>();
+		enemy5.set<CollisionLayer>({ LAYER_ENEMY });
 		enemy5.set_override<Health>({ health });
 		enemy5.add<Orientation>();
 		enemy5.add<Position>();
@@ -250,6 +123,7 @@ bool GA::EnemyData::Load(std::shared_ptr<flecs::world> _game,
 	auto enemy6 = _game->lookup("Spaceship5.009");
 	if (enemy6.is_valid()) {
 		enemy6.override<Enemy>();
+		enemy6.set<CollisionLayer>({ LAYER_ENEMY });
 		enemy6.set_override<Health>({ health });
 		enemy6.add<Orientation>();
 		enemy6.add<Position>();
@@ -258,6 +132,7 @@ bool GA::EnemyData::Load(std::shared_ptr<flecs::world> _game,
 	auto enemy7 = _game->lookup("Spaceship5.008");
 	if (enemy7.is_valid()) {
 		enemy7.override<Enemy>();
+		enemy7.set<CollisionLayer>({ LAYER_ENEMY });
 		enemy7.set_override<Health>({ health });
 		enemy7.add<Orientation>();
 		enemy7.add<Position>();
@@ -266,6 +141,7 @@ bool GA::EnemyData::Load(std::shared_ptr<flecs::world> _game,
 	auto enemy8 = _game->lookup("Spaceship5.007");
 	if (enemy8.is_valid()) {
 		enemy8.override<Enemy>();
+		enemy8.set<CollisionLayer>({ LAYER_ENEMY });
 		enemy8.add<Orientation>();
 		enemy8.add<Position>();
 		enemy8.add<Collidable>();
@@ -273,6 +149,7 @@ bool GA::EnemyData::Load(std::shared_ptr<flecs::world> _game,
 	auto enemy9 = _game->lookup("Spaceship5.006");
 	if (enemy9.is_valid()) {
 		enemy9.override<Enemy>();
+		enemy9.set<CollisionLayer>({ LAYER_ENEMY });
 		enemy9.add<Orientation>();
 		enemy9.add<Position>();
 		enemy9.add<Collidable>();
@@ -280,6 +157,7 @@ bool GA::EnemyData::Load(std::shared_ptr<flecs::world> _game,
 	auto enemy10 = _game->lookup("Spaceship5.005");
 	if (enemy9.is_valid()) {
 		enemy9.override<Enemy>();
+		enemy9.set<CollisionLayer>({ LAYER_ENEMY });
 		enemy9.add<Orientation>();
 		enemy9.add<Position>();
 		enemy9.add<Collidable>();
@@ -287,6 +165,7 @@ bool GA::EnemyData::Load(std::shared_ptr<flecs::world> _game,
 	auto enemy11 = _game->lookup("Spaceship5.004");
 	if (enemy10.is_valid()) {
 		enemy10.override<Enemy>();
+		enemy10.set<CollisionLayer>({ LAYER_ENEMY });
 		enemy10.add<Orientation>();
 		enemy10.add<Position>();
 		enemy10.add<Collidable>();
@@ -294,6 +173,7 @@ bool GA::EnemyData::Load(std::shared_ptr<flecs::world> _game,
 	auto enemy12 = _game->lookup("Spaceship5.003");
 	if (enemy11.is_valid()) {
 		enemy11.override<Enemy>();
+		enemy11.set<CollisionLayer>({ LAYER_ENEMY });
 		enemy11.add<Orientation>();
 		enemy11.add<Position>();
 		enemy11.add<Collidable>();
@@ -301,6 +181,7 @@ bool GA::EnemyData::Load(std::shared_ptr<flecs::world> _game,
 	auto enemy13 = _game->lookup("Spaceship5.002");
 	if (enemy12.is_valid()) {
 		enemy12.override<Enemy>();
+		enemy12.set<CollisionLayer>({ LAYER_ENEMY });
 		enemy12.add<Orientation>();
 		enemy12.add<Position>();
 		enemy12.add<Collidable>();
@@ -308,6 +189,7 @@ bool GA::EnemyData::Load(std::shared_ptr<flecs::world> _game,
 	auto enemy14 = _game->lookup("Spaceship5.001");
 	if (enemy13.is_valid()) {
 		enemy13.override<Enemy>();
+		enemy13.set<CollisionLayer>({ LAYER_ENEMY });
 		enemy13.add<Orientation>();
 		enemy13.add<Position>();
 		enemy13.add<Collidable>();
@@ -315,6 +197,7 @@ bool GA::EnemyData::Load(std::shared_ptr<flecs::world> _game,
 	auto enemy15 = _game->lookup("Spaceship5");
 	if (enemy14.is_valid()) {
 		enemy14.override<Enemy>();
+		enemy14.set<CollisionLayer>({ LAYER_ENEMY });
 		enemy14.add<Orientation>();
 		enemy14.add<Position>();
 		enemy14.add<Collidable>();
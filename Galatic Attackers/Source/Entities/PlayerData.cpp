@@ -28,6 +28,7 @@ bool GA::PlayerData::Load(  std::shared_ptr<flecs::world> _game,
 	if (e.is_valid()) {
 		e.add<Player>();
 		e.add<Collidable>();
+		e.set<CollisionLayer>({ LAYER_PLAYER });
 		e.set<Material>({ red, green, blue });
 		e.set<Position>({ xstart, ystart });
 		e.set<ControllerID>({ 0 });
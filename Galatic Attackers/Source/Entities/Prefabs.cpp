@@ -4,37 +4,84 @@
 // I prefer them to the singleton design pattern 
 namespace 
 {
-	std::map<std::string, flecs::entity> prefabMap;
+	// open addressing hash table, must be a power of 2 and bigger than the prefab count
+	constexpr unsigned maxPrefabs = 64;
+	enum SLOT_STATE : unsigned char { EMPTY, USED, REMOVED };
+	struct SLOT {
+		GA::PREFAB_ID id = 0;
+		SLOT_STATE state = EMPTY;
+		flecs::entity prefab;
+	};
+	SLOT prefabTable[maxPrefabs];
+	// only used to report two names hashing to the same id
+	std::string prefabNames[maxPrefabs];
+
+	// slot holding this id, or maxPrefabs if it isn't registered
+	unsigned FindSlot(GA::PREFAB_ID prefabId)
+	{
+		for (unsigned probe = 0; probe < maxPrefabs; ++probe) {
+			unsigned slot = (prefabId + probe) & (maxPrefabs - 1);
+			if (prefabTable[slot].state == EMPTY)
+				break; // would have been placed here
+			if (prefabTable[slot].state == USED && prefabTable[slot].id == prefabId)
+				return slot;
+		}
+		return maxPrefabs;
+	}
 }
 // functions defined in this file have access to the data in the nameless namespace above
 namespace GA
 {
 	// interface implementations to access protected data set above
-	bool RegisterPrefab(const char* prefabName, const flecs::entity inPrefab)
+	bool RegisterPrefab(PREFAB_ID prefabId, const flecs::entity inPrefab, const char* prefabName)
 	{
-		auto iter = prefabMap.find(prefabName);
-		if (iter == prefabMap.end()) {
-			prefabMap[std::string(prefabName)] = inPrefab;
-			return true;
+		unsigned existing = FindSlot(prefabId);
+		if (existing != maxPrefabs) {
+			if (prefabName != nullptr && prefabNames[existing] != prefabName)
+				std::cout << "[Prefabs] \"" << prefabName << "\" has the same id as \""
+					<< prefabNames[existing] << "\", rename one of them" << std::endl;
+			return false; // already exists
+		}
+		for (unsigned probe = 0; probe < maxPrefabs; ++probe) {
+			unsigned slot = (prefabId + probe) & (maxPrefabs - 1);
+			if (prefabTable[slot].state != USED) {
+				prefabTable[slot] = { prefabId, USED, inPrefab };
+				prefabNames[slot] = (prefabName != nullptr) ? prefabName : "";
+				return true;
+			}
 		}
-		return false; // already exists
+		return false; // table is full, raise maxPrefabs
 	}
-	bool RetreivePrefab(const char* prefabName, flecs::entity& outPrefab)
+	bool RetreivePrefab(PREFAB_ID prefabId, flecs::entity& outPrefab)
 	{
-		auto iter = prefabMap.find(prefabName);
-		if (iter != prefabMap.end()) {
-			outPrefab = prefabMap[std::string(prefabName)];
+		unsigned slot = FindSlot(prefabId);
+		if (slot != maxPrefabs) {
+			outPrefab = prefabTable[slot].prefab;
 			return true;
 		}
 		return false; // prefab not found
 	}
-	bool UnregisterPrefab(const char* prefabName)
+	bool UnregisterPrefab(PREFAB_ID prefabId)
 	{
-		auto iter = prefabMap.find(prefabName);
-		if (iter != prefabMap.end()) {
-			prefabMap.erase(iter);
+		unsigned slot = FindSlot(prefabId);
+		if (slot != maxPrefabs) {
+			// leave a marker so ids that probed past this slot can still be found
+			prefabTable[slot] = { 0, REMOVED, flecs::entity() };
+			prefabNames[slot].clear();
 			return true;
 		}
 		return false; // prefab not found
 	}
+	bool RegisterPrefab(const char* prefabName, const flecs::entity inPrefab)
+	{
+		return RegisterPrefab(PrefabId(prefabName), inPrefab, prefabName);
+	}
+	bool RetreivePrefab(const char* prefabName, flecs::entity& outPrefab)
+	{
+		return RetreivePrefab(PrefabId(prefabName), outPrefab);
+	}
+	bool UnregisterPrefab(const char* prefabName)
+	{
+		return UnregisterPrefab(PrefabId(prefabName));
+	}
 }
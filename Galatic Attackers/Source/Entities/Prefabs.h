@@ -5,9 +5,27 @@
 // example space game (avoid name collisions)
 namespace GA
 {
+	// prefabs are stored by a hash of their name (32 bit FNV-1a)
+	// constexpr so hot code can do the hashing at compile time:
+	//	static constexpr PREFAB_ID lazerId = PrefabId("Lazer Bullet");
+	using PREFAB_ID = unsigned int;
+	constexpr PREFAB_ID PrefabId(const char* prefabName)
+	{
+		PREFAB_ID hash = 2166136261u;
+		for (; *prefabName != '\0'; ++prefabName) {
+			hash ^= static_cast<unsigned char>(*prefabName);
+			hash *= 16777619u;
+		}
+		return hash;
+	}
+	// fixed size table, no allocations when retreiving
+	bool RegisterPrefab(PREFAB_ID prefabId, const flecs::entity inPrefab, const char* prefabName = nullptr);
+	bool RetreivePrefab(PREFAB_ID prefabId, flecs::entity& outPrefab);
+	bool UnregisterPrefab(PREFAB_ID prefabId);
+	// name based versions, these just hash the name and call the ones above
 	bool RegisterPrefab(const char* prefabName, const flecs::entity inPrefab);
 	bool RetreivePrefab(const char* prefabName, flecs::entity &outPrefab);
 	bool UnregisterPrefab(const char* prefabName);
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,36 @@
+#include "PlayEventQueue.h"
+
+// each event type has its own fixed buffer, pushing only claims a slot with one atomic add
+bool GA::PlayEventQueue::Push(PLAY_EVENT type, const PLAY_EVENT_DATA& data)
+{
+	BUCKET& bucket = buckets[type];
+	unsigned slot = bucket.count.fetch_add(1, std::memory_order_relaxed);
+	if (slot >= Max_Frame_Events)
+		return false; // full, Dispatch reports how many were lost
+	bucket.events[slot] = data;
+	return true;
+}
+
+bool GA::PlayEventQueue::Subscribe(PLAY_EVENT type, HANDLER handler)
+{
+	if (type >= PLAY_EVENT::EVENT_COUNT || !handler)
+		return false;
+	buckets[type].handlers.push_back(std::move(handler));
+	return true;
+}
+
+// runs between frames when nothing else is pushing, so plain reads of the buffers are safe
+void GA::PlayEventQueue::Dispatch()
+{
+	for (unsigned type = 0; type < PLAY_EVENT::EVENT_COUNT; ++type) {
+		BUCKET& bucket = buckets[type];
+		unsigned pushed = bucket.count.exchange(0, std::memory_order_acquire);
+		if (pushed == 0)
+			continue;
+		unsigned count = G_SMALLER(pushed, Max_Frame_Events);
+		if (pushed > count)
+			std::cout << "[Events] dropped " << pushed - count << " events of type " << type << std::endl;
+		for (HANDLER& handler : bucket.handlers)
+			handler(bucket.events, count);
+	}
+}
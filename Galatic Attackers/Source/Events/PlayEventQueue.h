@@ -0,0 +1,34 @@
+// gameplay events are collected during the frame and handed out in batches once it's done
+#ifndef PLAYEVENTQUEUE_H
+#define PLAYEVENTQUEUE_H
+
+#include "Playevents.h"
+
+// example space game (avoid name collisions)
+namespace GA
+{
+	class PlayEventQueue
+	{
+	public:
+		// called with every event of one type pushed since the last dispatch
+		using HANDLER = std::function<void(const PLAY_EVENT_DATA* events, unsigned count)>;
+		// how many events of one type a single frame can hold, extras are dropped and reported
+		static constexpr unsigned Max_Frame_Events = 512;
+
+		// safe from any thread (flecs workers included), never blocks
+		bool Push(PLAY_EVENT type, const PLAY_EVENT_DATA& data);
+		// main thread only, before the game loop starts
+		bool Subscribe(PLAY_EVENT type, HANDLER handler);
+		// main thread only, once per frame after the ECS has progressed
+		void Dispatch();
+
+	private:
+		struct BUCKET {
+			std::atomic<unsigned> count{ 0 }; // slots claimed this frame, can pass Max_Frame_Events
+			PLAY_EVENT_DATA events[Max_Frame_Events];
+			std::vector<HANDLER> handlers;
+		} buckets[PLAY_EVENT::EVENT_COUNT];
+	};
+}
+
+#endif
@@ -6,12 +6,12 @@ namespace GA
 {
 	enum PLAY_EVENT {
 		ENEMY_DESTROYED,
-		EVENT_COUNT,
 		LOST_LIFE,
 		NEXT_LEVEL,
 		RESET_LEVEL,
 		WIN,
-		LOSE
+		LOSE,
+		EVENT_COUNT
 	};
 	struct PLAY_EVENT_DATA {
 		flecs::id entity_id; // which entity was affected?
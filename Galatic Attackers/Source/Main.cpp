@@ -1,8 +1,17 @@
 // handles everything
 #include "Application.h"
 // program entry point
-int main()
+int main(int argc, char* argv[])
 {
+	// offline level cook: GalacticAttackers --cook ../GameLevel_1.txt [../Models]
+	// writes ../GameLevel_1.glv, which LoadLevel maps instead of parsing the text from then on
+	if (argc >= 3 && std::strcmp(argv[1], "--cook") == 0) {
+		GW::SYSTEM::GLog log;
+		log.Create("cook_log.txt");
+		log.EnableConsoleLogging(true);
+		Level_Data level;
+		return level.CookLevel(argv[2], (argc > 3) ? argv[3] : "../Models", log) ? 0 : 1;
+	}
 	Application galacticAttackers;
 	if (galacticAttackers.Init()) {
 		if (galacticAttackers.Run()) {
@@ -11,4 +20,4 @@ int main()
 		
 	}
 	return 1;
-}
\ No newline at end of file
+}
@@ -2,6 +2,7 @@
 #include "../Components/Gameplay.h"
 #include "../Components/Identification.h"
 #include "../Components/Physics.h"
+#include "../Entities/BulletPool.h"
 #include "BulletLogic.h"
 #include <random>
 
@@ -16,56 +17,17 @@ bool GA::BulletLogic::Init(std::shared_ptr<flecs::world> _game,
 	game = _game;
 	gameConfig = _gameConfig;
 	levelData = _levelData;
-	// destroy any bullets that have the CollidedWith relationship
-	game->system<Bullet, Damage, Position>("Bullet System")
-		.each([this](flecs::entity e, Bullet, Damage& d, Position& p) {
-		// damage anything we come into contact with
-
-		auto pos = p.value;
-		{
-			e.each<CollidedWith>([&e, d, p, this](flecs::entity hit) {
-				if (hit.has<Health>() && hit.has<Enemy>()) {
-					auto enemy = hit.get<Position>()->value.y;
-					auto bullet = e.get<Position>()->value.y;
-					int currentHealth = hit.get<Health>()->value;
-					hit.set<Health>({ currentHealth - d.value });
-					ModelTransform* bulletT = e.get_mut<ModelTransform>();
-					levelData->levelTransforms[bulletT->rendererIndex] = bulletT->matrix;
-					bulletT->matrix.row4.x = 0;
-					bulletT->matrix.row4.y = 0;
-					e.destruct();
-
-
-					if (hit.get<Health>()->value <= 0)
-					{
-						ModelTransform* enemyT = hit.get_mut<ModelTransform>();
-						levelData->levelTransforms[enemyT->rendererIndex] = enemyT->matrix;
-						enemyT->matrix.row4.x = 200;
-						enemyT->matrix.row4.y = 200;
-						hit.destruct();
-					}
-
-					// reduce the amount of hits but the charged shot
-					if (e.has<ChargedShot>() && hit.get<Health>()->value <= 0)
-					{
-						int md_count = e.get<ChargedShot>()->max_destroy;
-						e.set<ChargedShot>({ md_count - 1 });
-					}
-				}
-				});
-			// if you have collidedWith realtionship then be destroyed
-			if (e.has<CollidedWith>(flecs::Wildcard)) {
-
-				if (e.has<ChargedShot>()) {
-
-					if (e.get<ChargedShot>()->max_destroy <= 0)
-						e.destruct();
-				}
-				else {
-					// play hit sound
-					e.destruct();
-				}
-			}
+	// destroy any bullets that touched something this frame
+	// Contacts is a world singleton so this runs once per frame over every contact
+	game->system<const Contacts>("Bullet System")
+		.each([this](flecs::entity, const Contacts& c) {
+		healthLeft.clear();
+		for (const auto& contact : c.pairs) {
+			// a contact is only stored once, either side could be the bullet
+			if (contact.a.is_alive() && contact.a.has<Bullet>())
+				ResolveHit(contact.a, contact.b);
+			if (contact.b.is_alive() && contact.b.has<Bullet>())
+				ResolveHit(contact.b, contact.a);
 		}
 			});
 
@@ -93,3 +55,40 @@ bool GA::BulletLogic::Activate(bool runSystem)
 	}
 	return false;
 }
+
+// damage anything the bullet came into contact with, then get rid of the bullet
+void GA::BulletLogic::ResolveHit(flecs::entity e, flecs::entity hit)
+{
+	const Damage* d = e.get<Damage>();
+	if (d != nullptr && hit.is_alive() && hit.has<Health>() && hit.has<Enemy>()) {
+		// two bullets hitting the same enemy in one frame both count
+		auto left = healthLeft.try_emplace(hit.id(), hit.get<Health>()->value).first;
+		// already out of health, the Enemy System removes it and adds the score
+		// so the bullet flies on whether or not that happened yet
+		if (left->second <= 0)
+			return;
+		left->second -= d->value;
+		hit.set<Health>({ left->second });
+		ModelTransform* bulletT = e.get_mut<ModelTransform>();
+		bulletT->matrix.row4.x = 0;
+		bulletT->matrix.row4.y = 0;
+		ReleaseBullet(e);
+
+		// reduce the amount of hits but the charged shot
+		if (e.has<ChargedShot>() && left->second <= 0)
+		{
+			int md_count = e.get<ChargedShot>()->max_destroy;
+			e.set<ChargedShot>({ md_count - 1 });
+		}
+	}
+	// touching anything at all gets rid of the bullet
+	if (e.has<ChargedShot>()) {
+
+		if (e.get<ChargedShot>()->max_destroy <= 0)
+			ReleaseBullet(e);
+	}
+	else {
+		// play hit sound
+		ReleaseBullet(e);
+	}
+}
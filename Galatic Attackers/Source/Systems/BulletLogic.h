@@ -16,6 +16,8 @@ namespace GA
 		// non-ownership handle to configuration settings
 		std::weak_ptr<const GameConfig> gameConfig;
 		std::shared_ptr<Level_Data> levelData;
+		// health each enemy hit this frame has left, the system is deferred so a set isn't seen by the next get
+		std::unordered_map<flecs::entity_t, int> healthLeft;
 	public:
 		// attach the required logic to the ECS 
 		bool Init(std::shared_ptr<flecs::world> _game,
@@ -25,6 +27,9 @@ namespace GA
 		bool Activate(bool runSystem);
 		// release any resources allocated by the system
 		bool Shutdown();
+	private:
+		// applies damage from bullet e to whatever it hit
+		void ResolveHit(flecs::entity e, flecs::entity hit);
 	};
 
 };
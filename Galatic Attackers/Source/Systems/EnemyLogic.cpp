@@ -13,156 +13,147 @@ using namespace GA; // Galactic Attackers
 // Connects logic to traverse any players and allow a controller to manipulate them
 bool GA::EnemyLogic::Init(std::shared_ptr<flecs::world> _game,
 	std::weak_ptr<const GameConfig> _gameConfig,
-	GW::CORE::GEventGenerator _eventPusher,
+	std::shared_ptr<PlayEventQueue> _playEvents,
 	std::shared_ptr<Level_Data> _levelData,
-	std::shared_ptr<bool> _pause,
-	std::vector<flecs::entity> _entityVect,
-	std::shared_ptr<bool> _youWin,
-	std::shared_ptr<int> _enemyCount,
-	std::shared_ptr<int> _score)
+	std::vector<flecs::entity> _entityVect)
 {
 	// save a handle to the ECS & game settings
 	game = _game;
 	gameConfig = _gameConfig;
-	eventPusher = _eventPusher;
+	playEvents = _playEvents;
 	levelData = _levelData;
-	pause = _pause;
 	entityVect = _entityVect;
-	youWin = _youWin;
-	enemyCount = _enemyCount;
-	(*enemyCount) = 12;
-	score = _score;
-
-	// destroy any bullets that have the CollidedWith relationship
-	game->system<Enemy, Health, Position>("Enemy System")
-		.each([this](flecs::entity e, Enemy, Health& h, Position& p) {
-		// if you have no health left be destroyed
-		if (!(*pause))
+	game->get_mut<GameState>()->enemyCount = 12;
+	std::shared_ptr<const GameConfig> readCfg = gameConfig.lock();
+	bool multithreaded = (*readCfg).at("Systems").at("multithreaded").as<bool>();
+	// resolved once here instead of every time the player gets hit
+	RetreivePrefab("Death", deathPrefab);
+	// the system needs the singleton to match, Application fills it in when a level loads
+	game->add<LevelEntities>();
+	// one marching state for the whole wave, members only keep their local slot
+	game->add<Formation>();
+
+	// enemies join the formation at wherever the level placed them
+	game->system<const ModelTransform, const Formation>("Formation Join")
+		.term_at(2).singleton()
+		.with<Enemy>().without<FormationSlot>()
+		.each([](flecs::entity e, const ModelTransform& t, const Formation& f) {
+		FormationSlot slot = { t.matrix };
+		slot.local.row4.x -= f.offset.x;
+		slot.local.row4.y -= f.offset.y;
+		e.set<FormationSlot>(slot);
+	});
+
+	// step the shared offset once per frame instead of every enemy stepping itself
+	game->system<Formation, const GameState>("Formation System")
+		.term_at(1).singleton()
+		.term_at(2).singleton()
+		.each([](Formation& f, const GameState& state) {
+		f.stepped = false;
+		if (state.pause)
+			return;
+		f.offset.x += (f.moveRight) ? f.stepX : -f.stepX;
+		f.timesMoved += (f.moveRight) ? 1 : -1;
+		if ((f.moveRight && f.timesMoved >= f.stepsPerRow) ||
+			(!f.moveRight && f.timesMoved <= 0))
 		{
-			if (e.get<Health>()->value <= 0) {
+			f.offset.y -= f.dropY;
+			f.moveRight = !f.moveRight;
+		}
+		f.stepped = true;
+	});
+
+	// resolve every member's world transform from its slot in one linear pass, Transform Sync hands them to the renderer
+	// self() keeps the columns owned, writing one shared from a prefab would move every enemy of that prefab at once
+	game->system<const FormationSlot, ModelTransform, ModelBoundary, const Formation>("Formation Members")
+		.term_at(2).self()
+		.term_at(3).self()
+		.term_at(4).singleton()
+		.iter([this](flecs::iter& it, const FormationSlot* slot,
+			ModelTransform* t, ModelBoundary* b, const Formation* f) {
+		if (!f->stepped)
+			return;
+		for (auto i : it) {
+			t[i].matrix = slot[i].local;
+			t[i].matrix.row4.x += f->offset.x;
+			t[i].matrix.row4.y += f->offset.y;
+			b[i].obb.center.x = t[i].matrix.row4.x;
+			b[i].obb.center.y = t[i].matrix.row4.y;
+		}
+	});
+
+	// clean up enemies that ran out of health and check how far the wave has come
+	// everything the loop touches is in the signature, so it walks columns instead of looking components up
+	// shared state is atomic and commands go through the iterator's stage, so it can run on worker threads
+	// Kick writes the transform column, self() makes sure it is the enemy's own and not its prefab's
+	game->system<const Health, Position, ModelTransform, FormationSlot*, const LevelEntities, GameState>("Enemy System")
+		.term_at(3).self()
+		.term_at(5).singleton()
+		.term_at(6).singleton()
+		.with<Enemy>()
+		.multi_threaded(multithreaded)
+		.iter([this](flecs::iter& it, const Health* h, Position* p,
+			ModelTransform* t, FormationSlot* slot, const LevelEntities* level, GameState* state) {
+		if (state->pause)
+			return;
+		for (auto i : it) {
+			// if you have no health left be destroyed
+			if (h[i].value <= 0) {
 				// play explode sound
-				GA::PLAY_EVENT_DATA x;
-				GW::GEvent explode;
-				explode.Write(GA::PLAY_EVENT::ENEMY_DESTROYED, x);
-				eventPusher.Push(explode);
-				e.destruct();
-				(*enemyCount)--;
-				*score += 100;
+				playEvents->Push(GA::PLAY_EVENT::ENEMY_DESTROYED, { it.entity(i) });
+				it.entity(i).destruct();
+				state->enemyCount--;
+				state->score += 100;
 			}
 
-			ModelTransform* edit = e.get_mut<ModelTransform>();
-			TimesMoved* tm = e.get_mut<TimesMoved>();
-			Movement* move = e.get_mut<Movement>();
-			Location* loc = e.get_mut<Location>();
-			timer = 0;
-			loc->location = 60.0f;
-			if (move->moveRight)
+			// enemies that haven't joined the formation yet have no slot
+			FormationSlot* local = (slot) ? &slot[i] : nullptr;
+			// only the first enemy to reach the shield takes it out
+			if (t[i].matrix.row4.y <= 60.0f && shieldon1.exchange(false))
 			{
-				timer--;
-				if (timer <= 0)
-				{
-					GW::MATH::GMatrix::TranslateGlobalF(edit->matrix, GW::MATH::GVECTORF{ 0.75, 0, 0, 1 }, edit->matrix);
-					levelData->levelTransforms[edit->rendererIndex] = edit->matrix;
-					e.get_mut<ModelBoundary>()->obb.center.x = edit->matrix.row4.x;
-					e.get_mut<ModelBoundary>()->obb.center.y = edit->matrix.row4.y;
-
-					tm->timesMoved++;
-					timer = e.delta_time() * 20;
-
-					if (tm->timesMoved >= 28)
-					{
-						GW::MATH::GMatrix::TranslateGlobalF(edit->matrix, GW::MATH::GVECTORF{ 0, -3, 0, 1 }, edit->matrix);
-						levelData->levelTransforms[edit->rendererIndex] = edit->matrix;
-						e.get_mut<ModelBoundary>()->obb.center.x = edit->matrix.row4.x;
-						e.get_mut<ModelBoundary>()->obb.center.y = edit->matrix.row4.y;
-
-						move->moveRight = false;
-					}
+				Kick(t[i], local);
+				flecs::entity a = level->shield;
+				if (a.is_alive()) {
+					a.mut(it).destruct();
+					state->enemyCount--;
 				}
-
 			}
-			else if (!move->moveRight)
-			{
-				timer--;
-				if (timer <= 0)
-				{
-					GW::MATH::GMatrix::TranslateGlobalF(edit->matrix, GW::MATH::GVECTORF{ -0.75, 0, 0, 1 }, edit->matrix);
-					levelData->levelTransforms[edit->rendererIndex] = edit->matrix;
-					e.get_mut<ModelBoundary>()->obb.center.x = edit->matrix.row4.x;
-					e.get_mut<ModelBoundary>()->obb.center.y = edit->matrix.row4.y;
-
-					tm->timesMoved--;
-					timer = e.delta_time() * 20;
-
-					if (tm->timesMoved <= 0)
-					{
-						GW::MATH::GMatrix::TranslateGlobalF(edit->matrix, GW::MATH::GVECTORF{ 0, -3, 0, 1 }, edit->matrix);
-						levelData->levelTransforms[edit->rendererIndex] = edit->matrix;
-						e.get_mut<ModelBoundary>()->obb.center.x = edit->matrix.row4.x;
-						e.get_mut<ModelBoundary>()->obb.center.y = edit->matrix.row4.y;
 
-						move->moveRight = true;
-					}
-				}
-			}
-
-			if (shieldon1)
-			{
-				if (edit->matrix.row4.y <= loc->location)
-				{
-					GW::MATH::GMatrix::TranslateGlobalF(edit->matrix, GW::MATH::GVECTORF{ 0, 500, 0, 1 }, edit->matrix);
-					levelData->levelTransforms[edit->rendererIndex] = edit->matrix;
-					auto a = game->lookup("shield");
-					if (a.is_valid()) {
-						a.destruct();
-						(*enemyCount)--;
-					}
-					shieldon1 = false;
-				}
-			}
-
-			if (edit->matrix.row4.y <= 30)
+			if (t[i].matrix.row4.y <= 30)
 			{
-				GW::MATH::GMatrix::TranslateGlobalF(edit->matrix, GW::MATH::GVECTORF{ 0, 500, 0, 1 }, edit->matrix);
-				levelData->levelTransforms[edit->rendererIndex] = edit->matrix;
-				flecs::entity playerDeath;
-				RetreivePrefab("Death", playerDeath);
-				GW::AUDIO::GSound death = *playerDeath.get<GW::AUDIO::GSound>();
+				Kick(t[i], local);
+				GW::AUDIO::GSound death = *deathPrefab.get<GW::AUDIO::GSound>();
 				death.Play();
-				auto live = game->lookup("life 1");
-				if (live.is_valid())
+				flecs::entity live = level->lives[0];
+				if (live.is_alive())
 				{
-					live.destruct();
+					live.mut(it).destruct();
 				}
 				else {
-					auto live2 = game->lookup("life 2");
-					if (live2.is_valid())
+					flecs::entity live2 = level->lives[1];
+					if (live2.is_alive())
 					{
-						live2.destruct();
+						live2.mut(it).destruct();
 
 					}
 					else
 					{
-						auto live3 = game->lookup("life 3");
-						if (live3.is_valid())
+						flecs::entity live3 = level->lives[2];
+						if (live3.is_alive())
 						{
-							live3.destruct();
-							auto player = game->lookup("Player");
-							player.destruct();
+							live3.mut(it).destruct();
+							flecs::entity player = level->player;
+							player.mut(it).destruct();
 
-							GA::PLAY_EVENT_DATA y;
-							GW::GEvent youLose;
-							youLose.Write(GA::PLAY_EVENT::LOSE, y);
-							eventPusher.Push(youLose);
+							playEvents->Push(GA::PLAY_EVENT::LOSE, { player });
 							std::cout << "Player Dies...You Lose";
 						}
 					}
 				}
 			}
-			p.value = { 0, 0 };
+			p[i].value = { 0, 0 };
 		}
-
-			});
+	});
 
 	return true;
 
@@ -171,6 +162,9 @@ bool GA::EnemyLogic::Init(std::shared_ptr<flecs::world> _game,
 // Free any resources used to run this system
 bool GA::EnemyLogic::Shutdown()
 {
+	game->entity("Formation Join").destruct();
+	game->entity("Formation System").destruct();
+	game->entity("Formation Members").destruct();
 	game->entity("Enemy System").destruct();
 	// invalidate the shared pointers
 	game.reset();
@@ -182,27 +176,24 @@ bool GA::EnemyLogic::Shutdown()
 bool GA::EnemyLogic::Activate(bool runSystem)
 {
 	if (runSystem) {
+		game->entity("Formation Join").enable();
+		game->entity("Formation System").enable();
+		game->entity("Formation Members").enable();
 		game->entity("Enemy System").enable();
 	}
 	else {
+		game->entity("Formation Join").disable();
+		game->entity("Formation System").disable();
+		game->entity("Formation Members").disable();
 		game->entity("Enemy System").disable();
 	}
 	return false;
 }
 
-bool GA::EnemyLogic::FireLasersEnemy(flecs::world& stage, Position origin)
+// push an enemy far out of play, its slot moves too so the formation keeps it there
+void GA::EnemyLogic::Kick(ModelTransform& edit, FormationSlot* slot)
 {
-	// Grab laser prefab
-	flecs::entity bullet;
-	RetreivePrefab("Lazer Bullet", bullet);
-
-	// Laser start shoot position
-	origin.value.x -= 0.05f;
-	auto laserLeft = stage.entity().is_a(bullet)
-		.set<Position>(origin);
-	origin.value.x += 0.1f;
-	auto laserRight = stage.entity().is_a(bullet)
-		.set<Position>(origin);
-
-	return true;
+	GW::MATH::GMatrix::TranslateGlobalF(edit.matrix, GW::MATH::GVECTORF{ 0, 500, 0, 1 }, edit.matrix);
+	if (slot)
+		slot->local.row4.y += 500;
 }
\ No newline at end of file
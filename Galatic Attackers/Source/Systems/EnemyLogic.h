@@ -6,6 +6,8 @@
 #include "../GameConfig.h"
 #include "../Entities/EnemyData.h"
 #include "../Components/Physics.h"
+#include "../Components/Components.h"
+#include "../Events/PlayEventQueue.h"
 
 
 // example space game (avoid name collisions)
@@ -18,31 +20,25 @@ namespace GA
 		// non-ownership handle to configuration settings
 		std::weak_ptr<const GameConfig> gameConfig;
 		// handle to events
-		GW::CORE::GEventGenerator eventPusher;
+		std::shared_ptr<PlayEventQueue> playEvents;
 		std::shared_ptr<Level_Data> levelData;
-		std::shared_ptr<bool> pause;
 		std::vector<flecs::entity> entityVect;
-		std::shared_ptr<bool> youWin;
-		std::shared_ptr<int> enemyCount;
-		std::shared_ptr<int> score;
-		bool shieldon1 = true;
+		std::atomic<bool> shieldon1{ true };
+		// plays when the player loses a life
+		flecs::entity deathPrefab;
 
 	public:
 		// attach the required logic to the ECS 
 		bool Init(std::shared_ptr<flecs::world> _game,
 			std::weak_ptr<const GameConfig> _gameConfig,
-			GW::CORE::GEventGenerator _eventPusher, std::shared_ptr<Level_Data> _levelData, std::shared_ptr<bool> _pause, std::vector<flecs::entity> _entityVect, std::shared_ptr<bool> _youWin, std::shared_ptr<int> _enemyCount, std::shared_ptr<int> _score);
+			std::shared_ptr<PlayEventQueue> _playEvents, std::shared_ptr<Level_Data> _levelData, std::vector<flecs::entity> _entityVect);
 		// control if the system is actively running
 		bool Activate(bool runSystem);
 		// release any resources allocated by the system
 		bool Shutdown();
-		bool moveRight;
-		//int timesMoved = 0;
-		float timer;
-		
 
 	private:
-		bool FireLasersEnemy(flecs::world& stage, GA::Position origin);
+		void Kick(ModelTransform& edit, FormationSlot* slot);
 
 	};
 
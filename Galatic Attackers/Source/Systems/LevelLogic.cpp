@@ -1,4 +1,3 @@
-#include <random>
 #include "LevelLogic.h"
 #include "../Components/Identification.h"
 #include "../Components/Physics.h"
@@ -8,6 +7,35 @@
 
 using namespace GA; // Example Space Game
 
+namespace
+{
+	// "Spaceship5, Enemy Type2*3" -> one group per prefab with how many of it to spawn
+	std::vector<GA::LevelLogic::WAVE_GROUP> ReadWave(const std::string& list)
+	{
+		std::vector<GA::LevelLogic::WAVE_GROUP> wave;
+		std::stringstream stream(list);
+		std::string entry;
+		while (std::getline(stream, entry, ',')) {
+			unsigned count = 1;
+			size_t star = entry.find('*');
+			if (star != std::string::npos) {
+				count = static_cast<unsigned>(std::strtoul(entry.c_str() + star + 1, nullptr, 10));
+				entry.erase(star);
+			}
+			entry.erase(0, entry.find_first_not_of(" \t"));
+			entry.erase(entry.find_last_not_of(" \t") + 1);
+			if (entry.empty() || count == 0)
+				continue;
+			flecs::entity prefab;
+			if (GA::RetreivePrefab(GA::PrefabId(entry.c_str()), prefab))
+				wave.push_back({ prefab, count });
+			else
+				std::cout << "[Level] unknown wave prefab \"" << entry << "\"" << std::endl;
+		}
+		return wave;
+	}
+}
+
 // Connects logic to traverse any players and allow a controller to manipulate them
 bool GA::LevelLogic::Init(	std::shared_ptr<flecs::world> _game,
 							std::weak_ptr<const GameConfig> _gameConfig,
@@ -19,196 +47,85 @@ bool GA::LevelLogic::Init(	std::shared_ptr<flecs::world> _game,
 	gameConfig = _gameConfig;
 	audioEngine = _audioEngine;
 	levelData = _levelData;
-	// create an asynchronus version of the world
-	gameAsync = game->async_stage(); // just used for adding stuff, don't try to read data
-	gameLock.Create();
 	// Pull enemy Y start location from config file
 	std::shared_ptr<const GameConfig> readCfg = _gameConfig.lock();
-	float enemy1startY = (*readCfg).at("Enemy1").at("ystart").as<float>();
-	float enemy1accmax = (*readCfg).at("Enemy1").at("accmax").as<float>();
-	float enemy1accmin = (*readCfg).at("Enemy1").at("accmin").as<float>();
+	profileSpawning = (*readCfg).at("Spawning").at("profile").as<bool>();
+	spawnThread = (*readCfg).at("Spawning").at("mode").as<std::string>() == "thread";
+	enemy1startY = (*readCfg).at("Enemy1").at("ystart").as<float>();
+	enemy1accmax = (*readCfg).at("Enemy1").at("accmax").as<float>();
+	enemy1accmin = (*readCfg).at("Enemy1").at("accmin").as<float>();
 	// level one info
 	float spawnDelay = (*readCfg).at("Level1").at("spawndelay").as<float>();
-	
-	// spins up a job in a thread pool to invoke a function at a regular interval
-	timedEvents.Create(spawnDelay * 100000, [this, enemy1startY, enemy1accmax, enemy1accmin]() {
-		// compute random spawn location
-		std::random_device rd;  // Will be used to obtain a seed for the random number engine
-		std::mt19937 gen(rd()); // Standard mersenne_twister_engine seeded with rd()
-		std::uniform_real_distribution<float> x_range(-0.9f, +0.9f);
-		std::uniform_real_distribution<float> a_range(enemy1accmin, enemy1accmax);
-		float Xstart = x_range(gen); // normal rand() doesn't work great multi-threaded
-		float accel = a_range(gen);
-		// grab enemy type 1 prefab
-		flecs::entity et1;
-		flecs::entity et2;
-		flecs::entity et3;
-		flecs::entity et4;
-		flecs::entity et5;
-		flecs::entity et6;
-		flecs::entity et7;
-		flecs::entity et8;
-		flecs::entity et9;
-		flecs::entity et10;
-		flecs::entity et11;
-		flecs::entity et12;
+	// prefabs are registered before systems start, so the wave can be resolved up front
+	wave = ReadWave((*readCfg).at("Level1").at("wave").as<std::string>());
+	// waves get their own sequence so a recorded [Random] seed replays the same spawns
+	spawnRandom = Random::Stream("Spawning");
+	// first wave after a second, then one every spawndelay * 100 seconds
+	int waveSeconds = G_LARGER(1, static_cast<int>(spawnDelay * 100 + 0.5f));
 
-		if (RetreivePrefab("Spaceship5", et1)) {
-			// you must ensure the async_stage is thread safe as it has no built-in synchronization
-			gameLock.LockSyncWrite();
-			// this method of using prefabs is pretty conveinent
-			gameAsync.entity().is_a(et1)
-				.set<Velocity>({ 0,0 })
-				.set<Acceleration>({ 0, accel })
-				.set<Position>({ Xstart, enemy1startY });
-			///provide a set matrix     
-			// be sure to unlock when done so the main thread can safely merge the changes
-			gameLock.UnlockSyncWrite();
-		}
-		if (RetreivePrefab("Enemy Type2", et2)) {
-			// you must ensure the async_stage is thread safe as it has no built-in synchronization
-			gameLock.LockSyncWrite();
-			// this method of using prefabs is pretty conveinent
-			gameAsync.entity().is_a(et2)
-				.set<Velocity>({ 0,0 })
-				.set<Acceleration>({ 0, accel })
-				.set<Position>({ Xstart, enemy1startY });
-			///provide a set matrix     
-			// be sure to unlock when done so the main thread can safely merge the changes
-			gameLock.UnlockSyncWrite();
-		}
-		if (RetreivePrefab("Enemy Type3", et3)) {
-			// you must ensure the async_stage is thread safe as it has no built-in synchronization
-			gameLock.LockSyncWrite();
-			// this method of using prefabs is pretty conveinent
-			gameAsync.entity().is_a(et3)
-				.set<Velocity>({ 0,0 })
-				.set<Acceleration>({ 0, accel })
-				.set<Position>({ Xstart, enemy1startY });
-			///provide a set matrix     
-			// be sure to unlock when done so the main thread can safely merge the changes
-			gameLock.UnlockSyncWrite();
-		}
-		if (RetreivePrefab("Enemy Type4", et4)) {
-			// you must ensure the async_stage is thread safe as it has no built-in synchronization
-			gameLock.LockSyncWrite();
-			// this method of using prefabs is pretty conveinent
-			gameAsync.entity().is_a(et4)
-				.set<Velocity>({ 0,0 })
-				.set<Acceleration>({ 0, accel })
-				.set<Position>({ Xstart, enemy1startY });
-			///provide a set matrix     
-			// be sure to unlock when done so the main thread can safely merge the changes
-			gameLock.UnlockSyncWrite();
-		}
-		if (RetreivePrefab("Enemy Type5", et5)) {
-			// you must ensure the async_stage is thread safe as it has no built-in synchronization
-			gameLock.LockSyncWrite();
-			// this method of using prefabs is pretty conveinent
-			gameAsync.entity().is_a(et5)
-				.set<Velocity>({ 0,0 })
-				.set<Acceleration>({ 0, accel })
-				.set<Position>({ Xstart, enemy1startY });
-			///provide a set matrix     
-			// be sure to unlock when done so the main thread can safely merge the changes
-			gameLock.UnlockSyncWrite();
-		}
-		if (RetreivePrefab("Enemy Type6", et6)) {
-			// you must ensure the async_stage is thread safe as it has no built-in synchronization
-			gameLock.LockSyncWrite();
-			// this method of using prefabs is pretty conveinent
-			gameAsync.entity().is_a(et6)
-				.set<Velocity>({ 0,0 })
-				.set<Acceleration>({ 0, accel })
-				.set<Position>({ Xstart, enemy1startY });
-			///provide a set matrix     
-			// be sure to unlock when done so the main thread can safely merge the changes
-			gameLock.UnlockSyncWrite();
-		}
-		if (RetreivePrefab("Enemy Type7", et7)) {
-			// you must ensure the async_stage is thread safe as it has no built-in synchronization
-			gameLock.LockSyncWrite();
-			// this method of using prefabs is pretty conveinent
-			gameAsync.entity().is_a(et7)
-				.set<Velocity>({ 0,0 })
-				.set<Acceleration>({ 0, accel })
-				.set<Position>({ Xstart, enemy1startY });
-			///provide a set matrix     
-			// be sure to unlock when done so the main thread can safely merge the changes
-			gameLock.UnlockSyncWrite();
-		}
-		if (RetreivePrefab("Enemy Type8", et8)) {
-			// you must ensure the async_stage is thread safe as it has no built-in synchronization
-			gameLock.LockSyncWrite();
-			// this method of using prefabs is pretty conveinent
-			gameAsync.entity().is_a(et8)
-				.set<Velocity>({ 0,0 })
-				.set<Acceleration>({ 0, accel })
-				.set<Position>({ Xstart, enemy1startY });
-			///provide a set matrix     
-			// be sure to unlock when done so the main thread can safely merge the changes
-			gameLock.UnlockSyncWrite();
-		}
-		if (RetreivePrefab("Enemy Type9", et9)) {
-			// you must ensure the async_stage is thread safe as it has no built-in synchronization
-			gameLock.LockSyncWrite();
-			// this method of using prefabs is pretty conveinent
-			gameAsync.entity().is_a(et9)
-				.set<Velocity>({ 0,0 })
-				.set<Acceleration>({ 0, accel })
-				.set<Position>({ Xstart, enemy1startY });
-			///provide a set matrix     
-			// be sure to unlock when done so the main thread can safely merge the changes
-			gameLock.UnlockSyncWrite();
-		}
-		if (RetreivePrefab("Enemy Type10", et10)) {
-			// you must ensure the async_stage is thread safe as it has no built-in synchronization
-			gameLock.LockSyncWrite();
-			// this method of using prefabs is pretty conveinent
-			gameAsync.entity().is_a(et10)
-				.set<Velocity>({ 0,0 })
-				.set<Acceleration>({ 0, accel })
-				.set<Position>({ Xstart, enemy1startY });
-			///provide a set matrix     
-			// be sure to unlock when done so the main thread can safely merge the changes
-			gameLock.UnlockSyncWrite();
-		}
-		if (RetreivePrefab("Enemy Type11", et11)) {
-			// you must ensure the async_stage is thread safe as it has no built-in synchronization
-			gameLock.LockSyncWrite();
-			// this method of using prefabs is pretty conveinent
-			gameAsync.entity().is_a(et11)
-				.set<Velocity>({ 0,0 })
-				.set<Acceleration>({ 0, accel })
-				.set<Position>({ Xstart, enemy1startY });
-			///provide a set matrix     
-			// be sure to unlock when done so the main thread can safely merge the changes
-			gameLock.UnlockSyncWrite();
-		}
-		if (RetreivePrefab("Enemy Type12", et12)) {
-			// you must ensure the async_stage is thread safe as it has no built-in synchronization
-			gameLock.LockSyncWrite();
-			// this method of using prefabs is pretty conveinent
-			gameAsync.entity().is_a(et12)
-				.set<Velocity>({ 0,0 })
-				.set<Acceleration>({ 0, accel })
-				.set<Position>({ Xstart, enemy1startY });
-			///provide a set matrix     
-			// be sure to unlock when done so the main thread can safely merge the changes
-			gameLock.UnlockSyncWrite();
-		}
-	}, 1000); // wait 5 seconds to start enemy wave
+	if (spawnThread) {
+		// spins up a job in a thread pool to invoke a function at a regular interval
+		// only worth it when building a wave is expensive, the commands still wait for the next frame
+		timedEvents.Create(waveSeconds * 1000, [this]() {
+			float Xstart, accel;
+			RollWave(Xstart, accel);
+			// hand the wave to the main thread, one command per group and no locks
+			for (const WAVE_GROUP& group : wave)
+				if (!commands.Push({ group.prefab, group.count, Xstart, enemy1startY, accel }))
+					break; // full, the main thread has fallen far behind so skip the rest of this wave
+		}, 1000); // wait a second to start enemy wave
+	}
+	else {
+		// one shot after a second like the daemon's delay, the first wave switches it to waveSeconds
+		flecs::timer spawnTimer = game->timer("Spawn Timer").timeout(1.0f);
+		firstWave = true;
+		// spawns in-frame on the main thread, no_readonly runs it on the real world so waves are created directly
+		game->system("Spawn System").kind(flecs::OnLoad)
+			.tick_source(spawnTimer)
+			.no_readonly()
+			.iter([this, spawnTimer, waveSeconds](flecs::iter& it) {
+			flecs::world world = it.world();
+			if (firstWave) {
+				firstWave = false;
+				flecs::timer(spawnTimer).interval(static_cast<float>(waveSeconds));
+			}
+			float Xstart, accel;
+			RollWave(Xstart, accel);
+			for (const WAVE_GROUP& group : wave)
+				RunCommand(world, { group.prefab, group.count, Xstart, enemy1startY, accel });
+		});
+	}
 
-	// create a system the runs at the end of the frame only once to merge async changes
+	// create a system the runs at the start of the frame only once to carry out queued commands
 	struct LevelSystem {}; // local definition so we control iteration counts
 	game->entity("Level System").add<LevelSystem>();
 	// only happens once per frame at the very start of the frame
-	game->system<LevelSystem>().kind(flecs::OnLoad) // first defined phase
-		.each([this](flecs::entity e, LevelSystem& s) {
-		// merge any waiting changes from the last frame that happened on other threads
-		gameLock.LockSyncWrite();
-		gameAsync.merge();
-		gameLock.UnlockSyncWrite();
+	// no_readonly gives it the real world (a sync point) so spawns don't go through the command buffer
+	game->system().kind(flecs::OnLoad) // first defined phase
+		.with<LevelSystem>()
+		.no_readonly()
+		.each([this](flecs::entity e) {
+		// drain whatever other threads queued since last frame, producers are never blocked
+		flecs::world world = e.world();
+		auto start = std::chrono::steady_clock::now();
+		unsigned depth = commands.Depth();
+		unsigned drained = commands.Drain([this, &world](const LEVEL_COMMAND& command) {
+			RunCommand(world, command);
+		});
+		if (profileSpawning) {
+			profile.drainSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			profile.depth += depth;
+			profile.drained += drained;
+			profile.maxDepth = G_LARGER(profile.maxDepth, depth);
+			if (++profile.frames >= 300) {
+				std::cout << "[Spawning] avg queue depth " << profile.depth / double(profile.frames)
+					<< " | max depth " << profile.maxDepth
+					<< " | drained " << profile.drained << " commands"
+					<< " | drain " << profile.drainSeconds * 1000.0 / profile.frames << "ms"
+					<< " | dropped (total) " << commands.Dropped() << std::endl;
+				profile = {};
+			}
+		}
 	});
 
 	// Load and play level one's music
@@ -222,36 +139,56 @@ bool GA::LevelLogic::Init(	std::shared_ptr<flecs::world> _game,
 bool GA::LevelLogic::Shutdown()
 {
 	timedEvents = nullptr; // stop adding enemies
-	gameAsync.merge(); // get rid of any remaining commands
+	commands.Drain([](const LEVEL_COMMAND&) {}); // get rid of any remaining commands
 	game->entity("Level System").destruct();
+	if (!spawnThread) {
+		game->entity("Spawn System").destruct();
+		game->entity("Spawn Timer").destruct();
+	}
 	// invalidate the shared pointers
 	game.reset();
 	gameConfig.reset();
 	return true;
 }
 
+// picks where the next wave starts and how fast it falls, every group in the wave shares them
+void GA::LevelLogic::RollWave(float& Xstart, float& accel)
+{
+	// only one thread spawns in either mode, so the stream needs no guarding
+	Xstart = spawnRandom.Range(-0.9f, +0.9f);
+	accel = spawnRandom.Range(enemy1accmin, enemy1accmax);
+}
+
+// spawns go through one bulk create per command, its table grows once and the components are written with it
+// only call this from a no_readonly system, ecs_bulk_init works on the real world and not on a stage
+void GA::LevelLogic::RunCommand(flecs::world& world, const LEVEL_COMMAND& command)
+{
+	spawnVelocity.assign(command.count, { { 0, 0 } });
+	spawnAcceleration.assign(command.count, { { 0, command.accel } });
+	spawnPosition.assign(command.count, { { command.x, command.y } });
+	void* data[] = { nullptr, spawnVelocity.data(), spawnAcceleration.data(), spawnPosition.data() };
+	ecs_bulk_desc_t desc = {};
+	desc.count = static_cast<int32_t>(command.count);
+	desc.ids[0] = ecs_pair(flecs::IsA, command.target);
+	desc.ids[1] = flecs::type_id<Velocity>();
+	desc.ids[2] = flecs::type_id<Acceleration>();
+	desc.ids[3] = flecs::type_id<Position>();
+	desc.data = data;
+	ecs_bulk_init(world, &desc);
+}
+
 // Toggle if a system's Logic is actively running
 bool GA::LevelLogic::Activate(bool runSystem)
 {
 	if (runSystem) {
 		game->entity("Level System").enable();
+		if (!spawnThread)
+			game->entity("Spawn System").enable();
 	}
 	else {
 		game->entity("Level System").disable();
+		if (!spawnThread)
+			game->entity("Spawn System").disable();
 	}
 	return false;
 }
-
-// **** SAMPLE OF MULTI_THREADED USE ****
-//flecs::world world; // main world
-//flecs::world async_stage = world.async_stage();
-//
-//// From thread
-//lock(async_stage_lock);
-//flecs::entity e = async_stage.entity().child_of(parent)...
-//unlock(async_stage_lock);
-//
-//// From main thread, periodic
-//lock(async_stage_lock);
-//async_stage.merge(); // merge all commands to main world
-//unlock(async_stage_lock);
\ No newline at end of file
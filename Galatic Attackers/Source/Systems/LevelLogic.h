@@ -7,27 +7,62 @@
 // Entities for players, enemies & bullets
 #include "../Entities/PlayerData.h"
 #include "../Entities/BulletData.h"
+#include "../Components/Physics.h"
+#include "../Utils/CommandQueue.h"
+#include "../Utils/Random.h"
 
 // example space game (avoid name collisions)
 namespace GA
 {
 	class LevelLogic
 	{
+	public:
+		// one prefab and how many of it each wave spawns ([Level1] wave in the config)
+		struct WAVE_GROUP {
+			flecs::entity prefab;
+			unsigned count;
+		};
+		// a spawn other threads hand to the main thread, carried out at the start of the next frame
+		struct LEVEL_COMMAND {
+			flecs::entity_t target; // prefab to spawn from
+			unsigned count; // how many to spawn
+			float x, y, accel; // where spawns start and how fast they fall
+		};
+		// queue any thread can push into, returns false if it was full
+		bool PushCommand(const LEVEL_COMMAND& command) { return commands.Push(command); }
+	private:
 		// shared connection to the main ECS engine
 		std::shared_ptr<flecs::world> game;
-		// async version of above for threaded operations
-		flecs::world gameAsync; 
-		// mutex used to protect access to gameAsync 
-		GW::CORE::GThreadShared gameLock;
+		// commands from other threads, never locks (room for a few seconds of waves)
+		CommandQueue<LEVEL_COMMAND, 256> commands;
+		// queue numbers printed when [Spawning] profile is on
+		bool profileSpawning = false;
+		struct SPAWN_PROFILE {
+			double drainSeconds;
+			unsigned long long depth, drained;
+			unsigned maxDepth, frames;
+		} profile = {};
+		void RunCommand(flecs::world& world, const LEVEL_COMMAND& command);
+		// component data for one bulk spawn, kept so waves don't allocate
+		std::vector<Velocity> spawnVelocity;
+		std::vector<Acceleration> spawnAcceleration;
+		std::vector<Position> spawnPosition;
 		// non-ownership handle to configuration settings
 		std::weak_ptr<const GameConfig> gameConfig;
 		// Level system will also load and switch music
 		GW::AUDIO::GAudio audioEngine;
 		std::shared_ptr<Level_Data> levelData;
 		GW::AUDIO::GMusic currentTrack;
-		// Used to spawn enemies at a regular intervals on another thread
+		// Used to spawn enemies at a regular intervals on another thread ([Spawning] mode=thread)
+		bool spawnThread = false;
+		bool firstWave = true; // the timer starts as a one second timeout and becomes an interval after it
 		GW::SYSTEM::GDaemon timedEvents;
 		GW::SYSTEM::GDaemon timedEvents2;
+		// what every spawn tick creates
+		std::vector<WAVE_GROUP> wave;
+		float enemy1startY, enemy1accmax, enemy1accmin;
+		Random spawnRandom;
+		void RollWave(float& Xstart, float& accel);
 	public:
 		// attach the required logic to the ECS 
 		bool Init(	std::shared_ptr<flecs::world> _game,
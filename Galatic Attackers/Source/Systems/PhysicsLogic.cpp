@@ -3,6 +3,35 @@
 #include "../Components/Components.h"
 #include "../Components/Identification.h"
 #include "../Entities/Prefabs.h"
+#include "../Entities/BulletPool.h"
+
+namespace
+{
+	// names used for each COLLISION_LAYER in the config
+	const char* layerNames[GA::LAYER_COUNT] = { "geometry", "player", "shield", "enemy", "bullet" };
+
+	// reads a comma separated list of layer names ("none" for nothing) into a bit mask
+	unsigned ReadLayerMask(const std::string& list)
+	{
+		unsigned mask = 0;
+		std::stringstream stream(list);
+		std::string name;
+		while (std::getline(stream, name, ',')) {
+			name.erase(0, name.find_first_not_of(" \t"));
+			name.erase(name.find_last_not_of(" \t") + 1);
+			if (name.empty() || name == "none")
+				continue;
+			unsigned layer = 0;
+			while (layer < GA::LAYER_COUNT && name != layerNames[layer])
+				++layer;
+			if (layer < GA::LAYER_COUNT)
+				mask |= 1u << layer;
+			else
+				std::cout << "[Physics] unknown collision layer \"" << name << "\"" << std::endl;
+		}
+		return mask;
+	}
+}
 
 bool GA::PhysicsLogic::Init(std::shared_ptr<flecs::world> _game,
 	std::weak_ptr<const GameConfig> _gameConfig,
@@ -12,6 +41,30 @@ bool GA::PhysicsLogic::Init(std::shared_ptr<flecs::world> _game,
 	game = _game;
 	gameConfig = _gameConfig;
 	levelData = _levelData;
+	// pick how collision pairs are found
+	std::shared_ptr<const GameConfig> readCfg = gameConfig.lock();
+	std::string mode = (*readCfg).at("Physics").at("broadphase").as<std::string>();
+	sweepAndPrune = (mode != "brute");
+	batchNarrowphase = (*readCfg).at("Physics").at("batch").as<bool>();
+	batchCache.useSimd = (*readCfg).at("Physics").at("simd").as<bool>();
+	// which layers get tested against each other, either side listing the other is enough
+	for (unsigned i = 0; i < LAYER_COUNT; ++i) {
+		unsigned mask = ReadLayerMask((*readCfg).at("CollisionLayers").at(layerNames[i]).as<std::string>());
+		for (unsigned j = 0; j < LAYER_COUNT; ++j) {
+			if ((mask >> j) & 1u) {
+				layerMasks[i] |= 1u << j;
+				layerMasks[j] |= 1u << i;
+			}
+		}
+	}
+	persistentContacts = (*readCfg).at("Physics").at("cache").as<bool>();
+	int threads = (*readCfg).at("Physics").at("threads").as<int>();
+	threadCount = (threads > 1) ? static_cast<unsigned>(threads) : 1;
+	// worker threads belong to the whole world, only multi threaded systems use them
+	if (threadCount > 1)
+		game->set_threads(threadCount);
+	// translation only touches the entity it runs on, so it can be split across those threads too
+	bool multithreaded = (*readCfg).at("Systems").at("multithreaded").as<bool>();
 	// **** MOVEMENT ****
 	// update velocity by acceleration
 	game->system<Velocity, const Acceleration>("Acceleration System")
@@ -22,22 +75,39 @@ bool GA::PhysicsLogic::Init(std::shared_ptr<flecs::world> _game,
 			});
 
 	// update position by velocity
+	// bullets also drag their transform & boundary along, they get their own system below
 	game->system<Position, const Velocity>("Translation System")
-		.each([this](flecs::entity e, Position& p, const Velocity& v) {
-		GW::MATH2D::GVECTOR2F speed;
-		GW::MATH2D::GVector2D::Scale2F(v.value, e.delta_time(), speed);
-		// adding is simple but doesn't account for orientation
-		GW::MATH2D::GVector2D::Add2F(speed, p.value, p.value);
-
-
-		if (e.has<Bullet>())
-		{
-			ModelTransform* bulletT = e.get_mut<ModelTransform>();
-			levelData->levelTransforms[bulletT->rendererIndex] = bulletT->matrix;
-			GW::MATH::GMatrix::TranslateGlobalF(bulletT->matrix, GW::MATH::GVECTORF{ 0, p.value.y, 0, 1 }, bulletT->matrix);
+		.without<Bullet>()
+		.multi_threaded(multithreaded)
+		.iter([](flecs::iter& it, Position* p, const Velocity* v) {
+		float dt = it.delta_time();
+		// velocity might be shared from a prefab, then every entity reads the same one
+		size_t vStep = it.is_self(2) ? 1 : 0;
+		for (auto i : it) {
+			// adding is simple but doesn't account for orientation
+			p[i].value.x += v[i * vStep].value.x * dt;
+			p[i].value.y += v[i * vStep].value.y * dt;
+		}
+			});
 
-			e.get_mut<ModelBoundary>()->obb.center.x = bulletT->matrix.row4.x;
-			e.get_mut<ModelBoundary>()->obb.center.y = bulletT->matrix.row4.y;
+	game->system<Position, const Velocity, ModelTransform, ModelBoundary>("Bullet Translation System")
+		.with<Bullet>()
+		.multi_threaded(multithreaded)
+		.iter([this](flecs::iter& it, Position* p, const Velocity* v, ModelTransform* t, ModelBoundary* b) {
+		float dt = it.delta_time();
+		size_t vStep = it.is_self(2) ? 1 : 0;
+		for (auto i : it) {
+			p[i].value.x += v[i * vStep].value.x * dt;
+			p[i].value.y += v[i * vStep].value.y * dt;
+			// same result as GMatrix::TranslateGlobalF by (0, y, 0), only y moves (scaled by each row's w)
+			GW::MATH::GMATRIXF& m = t[i].matrix;
+			m.row1.y += m.row1.w * p[i].value.y;
+			m.row2.y += m.row2.w * p[i].value.y;
+			m.row3.y += m.row3.w * p[i].value.y;
+			m.row4.y += m.row4.w * p[i].value.y;
+			// writing through the column flags it as changed for the collision query
+			b[i].obb.center.x = m.row4.x;
+			b[i].obb.center.y = m.row4.y;
 		}
 			});
 
@@ -46,55 +116,108 @@ bool GA::PhysicsLogic::Init(std::shared_ptr<flecs::world> _game,
 	game->system<const Position>("Cleanup System")
 		.each([](flecs::entity e, const Position& p) {
 		if (p.value.y > 200.0f || p.value.y < -0.0f) {
-			e.destruct();
+			// bullets go back to their pool, everything else is gone for good
+			if (e.has<Bullet>())
+				ReleaseBullet(e);
+			else
+				e.destruct();
 		}
 			});
 
 	// **** COLLISIONS ****
-	// due to wanting to loop through all collidables at once, we do this in two steps:
+	// due to wanting to loop through all collidables at once, we do this in three steps:
 	// 1. A System will gather all collidables into a shared std::vector
-	// 2. A second system will run after, testing/resolving all collidables against each other
-	queryCache = game->query<Collidable, Position, Orientation, ModelBoundary>();
-	// only happens once per frame at the very start of the frame
-	struct CollisionSystem {}; // local definition so we control iteration count (singular)
-	game->entity("Detect-Collisions").add<CollisionSystem>();
-	game->system<CollisionSystem>()
-		.each([this](CollisionSystem& s) {
+	// 2. A multi threaded system tests a slice of the pairs on each worker thread
+	// 3. A final system merges the slices and publishes the contacts
+	// everything is read only so iterating doesn't flag the tables as changed
+	// position & orientation are required but not read, only box or layer writes count as changes
+	queryCache = game->query_builder<const Collidable, const ModelBoundary, const CollisionLayer*>()
+		.with<Position>().inout_none()
+		.with<Orientation>().inout_none()
+		.build();
+	// results go into a singleton, only the world has it so these run once per frame
+	game->set<Contacts>({});
+	game->system<Contacts>("Gather-Collisions")
+		.each([this](flecs::entity, Contacts&) {
 		// This the base shape all objects use & draw, this might normally be a component collider.(ex:sphere/box)
 		/*constexpr GW::MATH2D::GVECTOR2F poly[polysize] = {
 			{ -0.5f, -0.5f }, { 0, 0.5f }, { 0.5f, -0.5f }, { 0, -0.25f }
 		};*/
 		// collect any and all collidable objects
-		queryCache.each([this](flecs::entity e, Collidable& c, Position& p, Orientation& o, ModelBoundary& m) {
-
-			SHAPE polygon; // compute buffer for this objects polygon
-			// This is critical, if you want to store an entity handle it must be mutable
+		bool anyChanged = false;
+		queryCache.iter([this, &anyChanged](flecs::iter& it, const Collidable*, const ModelBoundary* m, const CollisionLayer* l) {
+			// flecs tracks writes per table, if no box in this table was written and nothing was
+			// added or removed since last frame, every pair inside it keeps last frame's answer
+			unsigned char moved = (!persistentContacts || it.changed()) ? 1 : 0;
+			anyChanged |= (moved != 0);
+			// the boundary and layer might be shared from a prefab, then every entity reads the same one
+			size_t mStep = it.is_self(2) ? 1 : 0;
+			size_t lStep = it.is_self(3) ? 1 : 0;
+			for (auto i : it) {
+				// This is critical, if you want to store an entity handle it must be mutable
+				testOwners.push_back(it.entity(i)); // allows later changes
+				testCache.push_back(m[i * mStep].obb);
+				testLayers.push_back((l != nullptr && l[i * lStep].value < LAYER_COUNT) ?
+					l[i * lStep].value : static_cast<unsigned>(LAYER_GEOMETRY));
+				testMoved.push_back(moved);
+			}
+			});
+		// nothing collidable was written, added or removed, last frame's contacts still hold
+		// (a table that emptied out isn't visited, the count catches that)
+		reuseContacts = persistentContacts && !anyChanged && testCache.size() == previousCount;
+		if (reuseContacts) {
+			testCache.clear();
+			testOwners.clear();
+			testLayers.clear();
+			testMoved.clear();
+			return;
+		}
+		// the workers only read from this, so it must be ready before they start
+		PrepareDetect(sweepAndPrune);
+			});
 
-			polygon.owner = e; // allows later changes
-			polygon.poly = m.obb;
-			// add to vector
-			testCache.push_back(polygon);
+	// one worker entity per thread, flecs splits matching entities evenly between threads
+	workers.resize(threadCount);
+	for (unsigned i = 0; i < threadCount; ++i)
+		game->entity().set<CollisionWorker>({ i });
+	game->system<const CollisionWorker>("Collision Workers")
+		.multi_threaded(threadCount > 1)
+		.each([this](flecs::entity e, const CollisionWorker& w) {
+		// each thread writes to its own buffer, nothing shared is modified here
+		if (reuseContacts)
+			return;
+		DetectSlice(sweepAndPrune, persistentContacts, w.slice, threadCount, workers[w.slice]);
 			});
-		// loop through the testCahe resolving all collisions
-		for (int i = 0; i < testCache.size(); ++i) {
-			// the inner loop starts at the entity after you so you don't double check collisions
-			for (int j = i + 1; j < testCache.size(); ++j) {
 
-				// test the two world space polygons for collision
-				// possibly make this cheaper by leaving one of them local and using an inverse matrix
-				GW::MATH::GCollision::GCollisionCheck result;
-				GW::MATH::GCollision::TestOBBToOBBF(
-					testCache[i].poly, testCache[j].poly, result);
-				if (result == GW::MATH::GCollision::GCollisionCheck::COLLISION) {
-					// Create an ECS relationship between the colliders
-					// Each system can decide how to respond to this info independently
-					testCache[j].owner.add<CollidedWith>(testCache[i].owner);
-					testCache[i].owner.add<CollidedWith>(testCache[j].owner);
-				}
-			}
-		}
+	game->system<Contacts>("Detect-Collisions")
+		.each([this](flecs::entity e, Contacts& contacts) {
+		if (reuseContacts)
+			return; // contacts are left exactly as they were
+		// merge the slices, sorting puts them in brute force order no matter
+		// which thread found what, so every frame matches the single threaded run
+		hitCache.clear();
+		for (auto& worker : workers)
+			hitCache.insert(hitCache.end(), worker.hits.begin(), worker.hits.end());
+		std::sort(hitCache.begin(), hitCache.end(), [](const SweepAndPrune::PAIR& a, const SweepAndPrune::PAIR& b) {
+			return (a.first != b.first) ? a.first < b.first : a.second < b.second;
+		});
+		// Publish this frame's contacts, no components are added so nothing changes tables
+		// Each system can decide how to respond to this info independently
+		contacts.pairs.clear();
+		for (const auto& hit : hitCache)
+			contacts.pairs.push_back({ testOwners[hit.first], testOwners[hit.second] });
+		contacts.Index(); // shields look themselves up instead of scanning every pair
+		// a CollidedWith relationship used to be added to both entities per hit
+		contacts.tableMovesSaved = static_cast<unsigned>(hitCache.size() * 2);
+		// remember this frame so unmoved pairs can carry over into the next one
+		if (persistentContacts)
+			RememberContacts();
 		// wipe the test cache for the next frame (keeps capacity intact)
 		testCache.clear();
+		testOwners.clear();
+		testLayers.clear();
+		testMoved.clear();
+		hitCache.clear();
 			});
 	return true;
 }
@@ -104,12 +227,20 @@ bool GA::PhysicsLogic::Activate(bool runSystem)
 	if (runSystem) {
 		game->entity("Acceleration System").enable();
 		game->entity("Translation System").enable();
+		game->entity("Bullet Translation System").enable();
 		game->entity("Cleanup System").enable();
+		game->entity("Gather-Collisions").enable();
+		game->entity("Collision Workers").enable();
+		game->entity("Detect-Collisions").enable();
 	}
 	else {
 		game->entity("Acceleration System").disable();
 		game->entity("Translation System").disable();
+		game->entity("Bullet Translation System").disable();
 		game->entity("Cleanup System").disable();
+		game->entity("Gather-Collisions").disable();
+		game->entity("Collision Workers").disable();
+		game->entity("Detect-Collisions").disable();
 	}
 	return true;
 }
@@ -119,6 +250,120 @@ bool GA::PhysicsLogic::Shutdown()
 	queryCache.destruct(); // fixes crash on shutdown
 	game->entity("Acceleration System").destruct();
 	game->entity("Translation System").destruct();
+	game->entity("Bullet Translation System").destruct();
 	game->entity("Cleanup System").destruct();
+	game->entity("Gather-Collisions").destruct();
+	game->entity("Collision Workers").destruct();
+	game->entity("Detect-Collisions").destruct();
+	game->delete_with<CollisionWorker>();
 	return true;
 }
+
+void GA::PhysicsLogic::PrepareDetect(bool sweep)
+{
+	if (sweep == false)
+		return; // brute force works straight off testCache
+	unsigned count = static_cast<unsigned>(testCache.size());
+	broadphase.Update(testCache.data(), count);
+	if (batchNarrowphase == false)
+		return;
+	// lay the boxes out in sorted order, that way everything a box overlaps
+	// sits right after it and can be tested several at a time
+	batchCache.Clear();
+	for (unsigned i = 0; i < count; ++i)
+		batchCache.Add(testCache[broadphase.Sorted(i)], broadphase.Sorted(i));
+}
+
+void GA::PhysicsLogic::DetectSlice(bool sweep, bool cached, unsigned slice, unsigned sliceCount, WORKER& worker)
+{
+	worker.hits.clear();
+	unsigned count = static_cast<unsigned>(testCache.size());
+	// positions are dealt out round robin, crowded areas end up spread across every thread
+	for (unsigned i = slice; i < count; i += sliceCount) {
+		if (sweep == false) {
+			// the inner loop starts at the entity after you so you don't double check collisions
+			for (unsigned j = i + 1; j < count; ++j) {
+				// layers that never interact are skipped before any OBB math
+				if (Interacts(i, j) == false)
+					continue;
+				// neither one moved, the answer is the same as last frame
+				if (cached && !testMoved[i] && !testMoved[j]) {
+					if (WasTouching(i, j))
+						worker.hits.push_back({ i, j });
+					continue;
+				}
+				// test the two world space polygons for collision
+				// possibly make this cheaper by leaving one of them local and using an inverse matrix
+				GW::MATH::GCollision::GCollisionCheck result;
+				GW::MATH::GCollision::TestOBBToOBBF(
+					testCache[i], testCache[j], result);
+				if (result == GW::MATH::GCollision::GCollisionCheck::COLLISION)
+					worker.hits.push_back({ i, j });
+			}
+			continue;
+		}
+		unsigned overlaps = broadphase.Overlaps(i);
+		if (overlaps == 0)
+			continue;
+		// keep only the overlapping boxes whose layers can touch this one
+		unsigned a = broadphase.Sorted(i);
+		worker.candidates.clear();
+		for (unsigned j = i + 1; j <= i + overlaps; ++j) {
+			unsigned b = broadphase.Sorted(j);
+			if (Interacts(a, b) == false)
+				continue;
+			// neither one moved, the answer is the same as last frame
+			if (cached && !testMoved[a] && !testMoved[b]) {
+				if (WasTouching(a, b))
+					worker.hits.push_back((a < b) ? SweepAndPrune::PAIR{ a, b } : SweepAndPrune::PAIR{ b, a });
+				continue;
+			}
+			worker.candidates.push_back(j);
+		}
+		unsigned candidates = static_cast<unsigned>(worker.candidates.size());
+		if (candidates == 0)
+			continue;
+		if (batchNarrowphase) {
+			worker.batchHits.resize(candidates);
+			batchCache.TestList(i, worker.candidates.data(), candidates, worker.batchHits.data());
+		}
+		for (unsigned j = 0; j < candidates; ++j) {
+			unsigned b = broadphase.Sorted(worker.candidates[j]);
+			SweepAndPrune::PAIR pair = (a < b) ? SweepAndPrune::PAIR{ a, b } : SweepAndPrune::PAIR{ b, a };
+			if (batchNarrowphase) {
+				if (worker.batchHits[j] == 0)
+					continue;
+			}
+			else {
+				// one GCollision test per overlapping pair
+				GW::MATH::GCollision::GCollisionCheck result;
+				GW::MATH::GCollision::TestOBBToOBBF(
+					testCache[pair.first], testCache[pair.second], result);
+				if (result != GW::MATH::GCollision::GCollisionCheck::COLLISION)
+					continue;
+			}
+			worker.hits.push_back(pair);
+		}
+	}
+}
+
+bool GA::PhysicsLogic::WasTouching(unsigned a, unsigned b) const
+{
+	flecs::entity_t first = testOwners[a].id(), second = testOwners[b].id();
+	std::pair<flecs::entity_t, flecs::entity_t> key = (first < second) ?
+		std::make_pair(first, second) : std::make_pair(second, first);
+	return std::binary_search(previousHits.begin(), previousHits.end(), key);
+}
+
+void GA::PhysicsLogic::RememberContacts()
+{
+	// contacts by entity, entity ids carry a generation so a recycled id won't match
+	previousCount = testOwners.size();
+	previousHits.clear();
+	for (const auto& hit : hitCache) {
+		flecs::entity_t first = testOwners[hit.first].id(), second = testOwners[hit.second].id();
+		previousHits.push_back((first < second) ?
+			std::make_pair(first, second) : std::make_pair(second, first));
+	}
+	std::sort(previousHits.begin(), previousHits.end());
+}
@@ -6,6 +6,8 @@
 #include "../GameConfig.h"
 #include "../Components/Physics.h"
 #include "../Components/Components.h"
+#include "../Utils/Broadphase.h"
+#include "../Utils/OBBBatch.h"
 
 // example space game (avoid name collisions)
 namespace GA
@@ -18,15 +20,38 @@ namespace GA
 		std::weak_ptr<const GameConfig> gameConfig;
 		std::shared_ptr<Level_Data> levelData;
 		// used to cache collision queries
-		flecs::query<Collidable, Position, Orientation, ModelBoundary> queryCache;
+		flecs::query<const Collidable, const ModelBoundary, const CollisionLayer*> queryCache;
 		// defines what to be tested
 		static constexpr unsigned polysize = 4;
-		struct SHAPE {
-			GW::MATH::GOBBF poly;
-			flecs::entity owner;
+		// vectors used to save/cache all active collidables (same index = same collidable)
+		std::vector<GW::MATH::GOBBF> testCache;
+		std::vector<flecs::entity> testOwners;
+		std::vector<unsigned> testLayers;
+		std::vector<unsigned char> testMoved; // 1 if the box's table changed since last frame
+		// last frame's collidable count and contacts, pairs of boxes that haven't moved reuse the old answer
+		size_t previousCount = 0;
+		std::vector<std::pair<flecs::entity_t, flecs::entity_t>> previousHits; // sorted, smaller id first
+		bool reuseContacts = false; // set when no collidable changed at all this frame
+		// bit n of layerMasks[layer] is set when that layer can touch layer n ([CollisionLayers] config)
+		unsigned layerMasks[LAYER_COUNT] = {};
+		// culls pairs that can't touch so we don't run OBB tests on every combination
+		SweepAndPrune broadphase;
+		// SIMD friendly copy of testCache (in broadphase order) for the narrowphase
+		OBBBatch batchCache;
+		// pairs that actually collided this frame (indices into testCache)
+		std::vector<SweepAndPrune::PAIR> hitCache;
+		// scratch space for one slice of the pair tests, each worker thread only touches its own
+		struct WORKER {
+			std::vector<unsigned char> batchHits;
+			std::vector<unsigned> candidates; // overlapping boxes whose layers can touch
+			std::vector<SweepAndPrune::PAIR> hits;
 		};
-		// vector used to save/cache all active collidables
-		std::vector<SHAPE> testCache;
+		std::vector<WORKER> workers;
+		// settings pulled from the [Physics] section of the config
+		bool sweepAndPrune = true;
+		bool batchNarrowphase = true;
+		bool persistentContacts = true;
+		unsigned threadCount = 1;
 	public:
 		// attach the required logic to the ECS 
 		bool Init(	std::shared_ptr<flecs::world> _game,
@@ -36,6 +61,18 @@ namespace GA
 		bool Activate(bool runSystem);
 		// release any resources allocated by the system
 		bool Shutdown();
+	private:
+		// can boxes a & b (indices into testCache) ever touch
+		bool Interacts(unsigned a, unsigned b) const { return (layerMasks[testLayers[a]] >> testLayers[b]) & 1u; }
+		// sorts/lays out testCache so it can be split between threads (sweep or brute)
+		void PrepareDetect(bool sweep);
+		// tests every pair starting at positions slice, slice + sliceCount, ... into worker.hits
+		// cached lets pairs where neither box moved reuse last frame's answer
+		void DetectSlice(bool sweep, bool cached, unsigned slice, unsigned sliceCount, WORKER& worker);
+		// were boxes a & b (indices into testCache) touching last frame
+		bool WasTouching(unsigned a, unsigned b) const;
+		// saves this frame's boxes & contacts for the next one
+		void RememberContacts();
 	};
 
 };
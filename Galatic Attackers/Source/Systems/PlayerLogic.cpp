@@ -5,6 +5,7 @@
 #include "../Components/Gameplay.h"
 #include "../Components/Components.h"
 #include "../Entities/Prefabs.h"
+#include "../Entities/BulletPool.h"
 #include "../Events/Playevents.h"
 
 using namespace GW;
@@ -12,6 +13,12 @@ using namespace GA; // Example Space Game
 using namespace GW::INPUT; // input libs
 using namespace GW::AUDIO; // audio libs
 
+namespace
+{
+	// hashed at compile time, looked up on every shot
+	constexpr PREFAB_ID lazerBulletId = PrefabId("Lazer Bullet");
+}
+
 // Connects logic to traverse any players and allow a controller to manipulate them
 bool GA::PlayerLogic::Init(std::shared_ptr<flecs::world> _game,
 	std::weak_ptr<const GameConfig> _gameConfig,
@@ -19,10 +26,9 @@ bool GA::PlayerLogic::Init(std::shared_ptr<flecs::world> _game,
 	GW::INPUT::GBufferedInput _bufferedInput,
 	GW::INPUT::GController _controllerInput,
 	GW::AUDIO::GAudio _audioEngine,
-	GW::CORE::GEventGenerator _eventPusher,
+	std::shared_ptr<PlayEventQueue> _playEvents,
 	std::shared_ptr<Level_Data> _levelData, std::shared_ptr<int> _currentLevel,
-	std::shared_ptr<bool> _levelChange, std::shared_ptr<bool> _youWin, std::shared_ptr<bool> _youLose, std::shared_ptr<bool> _pause,
-	std::shared_ptr<int> _enemyCount)
+	std::shared_ptr<bool> _levelChange)
 {
 	// save a handle to the ECS & game settings
 	game = _game;
@@ -34,10 +40,9 @@ bool GA::PlayerLogic::Init(std::shared_ptr<flecs::world> _game,
 	levelData = _levelData;
 	currentLevel = _currentLevel;
 	levelChange = _levelChange;
-	youWin = _youWin;
-	youLose = _youLose;
-	pause = _pause;
-	enemyCount = _enemyCount;
+	playEvents = _playEvents;
+	// event handlers run outside of any system, the ref reads the singleton without queuing a command
+	gameState = game->get_ref<GameState>();
 
 	// Init any helper systems required for this task
 	std::shared_ptr<const GameConfig> readCfg = gameConfig.lock();
@@ -46,9 +51,12 @@ bool GA::PlayerLogic::Init(std::shared_ptr<flecs::world> _game,
 	chargeTime = (*readCfg).at("Player").at("chargeTime").as<float>();
 
 	// add logic for updating players
-	playerSystem = game->system<Player, Position, ControllerID>("Player System")
-		.iter([this, speed](flecs::iter it, Player*, Position* p, ControllerID* c) {
-		if (!(*pause))
+	// moving edits ModelTransform through get_mut, so flag the write for Transform Sync to see it this frame
+	playerSystem = game->system<Player, Position, ControllerID, GameState>("Player System")
+		.term_at(4).singleton()
+		.write<ModelTransform>()
+		.iter([this, speed](flecs::iter it, Player*, Position* p, ControllerID* c, GameState* state) {
+		if (!state->pause)
 		{
 			for (auto i : it)
 			{
@@ -87,21 +95,21 @@ bool GA::PlayerLogic::Init(std::shared_ptr<flecs::world> _game,
 						else if (edit->matrix.row4.x > 40)
 							edit->matrix.row4.x = 40;
 
-						levelData->levelTransforms[edit->rendererIndex] = edit->matrix;
+						it.entity(i).modified<ModelTransform>();
 					}
 				}
 
 				//	// fire weapon if they are in a firing state
 				if (it.entity(i).has<Firing>())
 				{
-					ModelTransform* edit = it.entity(i).get_mut<ModelTransform>();
-					FireLasers(it.entity(i).world(), edit->matrix.row4);
+					const ModelTransform* from = it.entity(i).get<ModelTransform>();
+					FireLasers(it.entity(i).world(), from->matrix.row4);
 					it.entity(i).remove<Firing>();
 				}
 
-				if ((*enemyCount) <= 0)
+				if (state->enemyCount <= 0)
 				{
-					(*youWin) = true;
+					state->youWin = true;
 				}
 			}
 			// process any cached button events after the loop (happens multiple times per frame)
@@ -116,57 +124,19 @@ bool GA::PlayerLogic::Init(std::shared_ptr<flecs::world> _game,
 	bufferedInput.Register(pressEvents);
 	controllerInput.Register(pressEvents);
 
-	// create the on explode handler
-	onExplode.Create([this](const GW::GEvent& e) {
-		GA::PLAY_EVENT event; GA::PLAY_EVENT_DATA eventData;
-		if (+e.Read(event, eventData) && event == GA::PLAY_EVENT::ENEMY_DESTROYED) {
-			// only in here if event matches
-		}
-		});
-
-
-	nextLevel.Create([this](const GW::GEvent& e) {
-		GA::PLAY_EVENT event; GA::PLAY_EVENT_DATA eventData;
-		if (+e.Read(event, eventData) && event == GA::PLAY_EVENT::NEXT_LEVEL) {
-			// only in here if event matches
-			GW::SYSTEM::GLog log;
-			++(*currentLevel);
-			(*levelChange) = true;
-		}
-		});
-
-	/*resetLevel.Create([this](const GW::GEvent& e) {
-		GA::PLAY_EVENT event; GA::PLAY_EVENT_DATA eventData;
-		if (+e.Read(event, eventData) && event == GA::PLAY_EVENT::RESET_LEVEL) {
-			// only in here if event matches
-			GW::SYSTEM::GLog log;
-			(*currentLevel) = 1;
-			(*levelChange) == true;
-			levelData->LoadLevel("../GameLevel_1.txt", "../Models", log);
-		}
-		});*/
+	// handlers get every event of their type from the frame at once
+	playEvents->Subscribe(GA::PLAY_EVENT::NEXT_LEVEL, [this](const GA::PLAY_EVENT_DATA* events, unsigned count) {
+		++(*currentLevel);
+		(*levelChange) = true;
+	});
 
-	youWon.Create([this](const GW::GEvent& e) {
-		GA::PLAY_EVENT event; GA::PLAY_EVENT_DATA eventData;
-		if (+e.Read(event, eventData) && event == GA::PLAY_EVENT::WIN) {
-			// only in here if event matches
-			*youWin = true;
-		}
-		});
+	playEvents->Subscribe(GA::PLAY_EVENT::WIN, [this](const GA::PLAY_EVENT_DATA* events, unsigned count) {
+		gameState->youWin = true;
+	});
 
-	youLost.Create([this](const GW::GEvent& e) {
-		GA::PLAY_EVENT event; GA::PLAY_EVENT_DATA eventData;
-		if (+e.Read(event, eventData) && event == GA::PLAY_EVENT::LOSE) {
-			// only in here if event matches
-			*youLose = true;
-		}
-		});
-
-	_eventPusher.Register(onExplode);
-	_eventPusher.Register(nextLevel);
-	_eventPusher.Register(resetLevel);
-	_eventPusher.Register(youWon);
-	_eventPusher.Register(youLost);
+	playEvents->Subscribe(GA::PLAY_EVENT::LOSE, [this](const GA::PLAY_EVENT_DATA* events, unsigned count) {
+		gameState->youLose = true;
+	});
 	return true;
 }
 
@@ -208,7 +178,7 @@ bool GA::PlayerLogic::ProcessInputEvents(flecs::world& stage)
 				if (k_data.data == G_KEY_SPACE) {
 					fire = true;
 					flecs::entity bullet;
-					RetreivePrefab("Lazer Bullet", bullet);
+					RetreivePrefab(lazerBulletId, bullet);
 					GW::AUDIO::GSound shoot = *bullet.get<GW::AUDIO::GSound>();
 					shoot.Play();
 				}
@@ -222,7 +192,9 @@ bool GA::PlayerLogic::ProcessInputEvents(flecs::world& stage)
 		}
 		if (fire) {
 			// grab player one and set them to a firing state
-			stage.entity("Player").add<Firing>();
+			const LevelEntities* level = stage.get<LevelEntities>();
+			if (level != nullptr && level->player.is_alive())
+				level->player.mut(stage).add<Firing>();
 		}
 	}
 	return true;
@@ -233,13 +205,18 @@ bool GA::PlayerLogic::FireLasers(flecs::world& stage, GW::MATH::GVECTORF& origin
 {
 	// Grab the prefab for a laser round
 	flecs::entity bullet;
-	RetreivePrefab("Lazer Bullet", bullet);
-
-	auto laserLeft = stage.entity().is_a(bullet)
-		.set<Position>({ origin.x, origin.y });
-
-	ModelTransform* bulletT = bullet.get_mut<ModelTransform>();
-	bulletT->matrix.row4.x = origin.x;
+	RetreivePrefab(lazerBulletId, bullet);
+
+	// reuse a spent bullet, every overridden component is reset from the prefab
+	flecs::entity laserLeft;
+	if (AcquireBullet(stage, laserLeft) == false)
+		return false;
+	ModelTransform bulletT = *bullet.get<ModelTransform>();
+	bulletT.matrix.row4.x = origin.x;
+	laserLeft.set<Position>({ origin.x, origin.y })
+		.set<ModelTransform>(bulletT)
+		.set<ModelBoundary>(*bullet.get<ModelBoundary>())
+		.set<Damage>(*bullet.get<Damage>());
 
 	return true;
 }
\ No newline at end of file
@@ -5,6 +5,8 @@
 // Contains our global game settings
 #include "../GameConfig.h"
 #include "../Components/Physics.h"
+#include "../Components/Gameplay.h"
+#include "../Events/PlayEventQueue.h"
 
 // example space game (avoid name collisions)
 namespace GA 
@@ -28,20 +30,12 @@ namespace GA
 		GW::CORE::GEventCache pressEvents;
 		// varibables used for charged shot timing
 		float chargeStart = 0, chargeEnd = 0, chargeTime;
-		// event responder
-		GW::CORE::GEventResponder onExplode;
-		GW::CORE::GEventResponder lostLife;
-		GW::CORE::GEventResponder nextLevel;
-		GW::CORE::GEventResponder resetLevel;
-		GW::CORE::GEventResponder youWon;
-		GW::CORE::GEventResponder youLost;
+		// gameplay events, handlers are subscribed in Init
+		std::shared_ptr<PlayEventQueue> playEvents;
 		std::shared_ptr<Level_Data> levelData;
 		std::shared_ptr<int> currentLevel;
 		std::shared_ptr<bool> levelChange;
-		std::shared_ptr<bool> youWin;
-		std::shared_ptr<bool> youLose;
-		std::shared_ptr<bool> pause;
-		std::shared_ptr<int> enemyCount;
+		flecs::ref<GameState> gameState;
 	public:
 		// attach the required logic to the ECS 
 		bool Init(	std::shared_ptr<flecs::world> _game,
@@ -50,11 +44,10 @@ namespace GA
 					GW::INPUT::GBufferedInput _bufferedInput,
 					GW::INPUT::GController _controllerInput,
 					GW::AUDIO::GAudio _audioEngine,
-					GW::CORE::GEventGenerator _eventPusher,
+					std::shared_ptr<PlayEventQueue> _playEvents,
 					std::shared_ptr<Level_Data> _levelData,
 					std::shared_ptr<int> _currentLevel,
-					std::shared_ptr<bool> _levelChange, std::shared_ptr<bool> _youWin, std::shared_ptr<bool> _youLose, std::shared_ptr<bool> _pause,
-					std::shared_ptr<int> _enemyCount);
+					std::shared_ptr<bool> _levelChange);
 		// control if the system is actively running
 		bool Activate(bool runSystem);
 		// release any resources allocated by the system
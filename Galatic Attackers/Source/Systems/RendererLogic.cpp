@@ -8,6 +8,7 @@
 #include <d3dcompiler.h>
 #include "../Components/Gameplay.h"
 #include "../Entities/Prefabs.h"
+#include <cassert>
 #pragma comment(lib, "d3dcompiler.lib") 
 using namespace GA; // Example Space Game
 
@@ -26,11 +27,8 @@ bool GA::D3DRendererLogic::Init(std::shared_ptr<flecs::world> _game,
 	GW::SYSTEM::GWindow _window,
 	std::shared_ptr<Level_Data> _levelData,
 	std::shared_ptr<bool> _levelChange,
-	std::shared_ptr<bool> _youWin,
-	std::shared_ptr<bool> _youLose,
 	std::vector<flecs::entity> _entityVec,
-	std::shared_ptr<int> _currentLevel,
-	std::shared_ptr<int> _score)
+	std::shared_ptr<int> _currentLevel)
 {
 	// save a handle to the ECS & game settings
 	game = _game;
@@ -39,12 +37,12 @@ bool GA::D3DRendererLogic::Init(std::shared_ptr<flecs::world> _game,
 	window = _window;
 	levelData = _levelData;
 	levelChange = _levelChange;
-	youWin = _youWin;
-	youLose = _youLose;
 	entityVec = _entityVec;
 	currentLevel = _currentLevel;
-	score = _score;
-	*score = 0;
+	gameState = game->get_ref<GameState>();
+	gameState->score = 0;
+	std::shared_ptr<const GameConfig> readCfg = gameConfig.lock();
+	interpolate = (*readCfg).at("Simulation").at("interpolate").as<bool>();
 
 	// Setup all vulkan resources
 	if (LoadShaders3D() == false)
@@ -141,15 +139,18 @@ bool GA::D3DRendererLogic::Activate(bool runSystem)
 {
 	if (startDraw.is_alive() &&
 		updateDraw.is_alive() &&
+		transformSync.is_alive() &&
 		completeDraw.is_alive()) {
 		if (runSystem) {
 			startDraw.enable();
 			updateDraw.enable();
+			transformSync.enable();
 			completeDraw.enable();
 		}
 		else {
 			startDraw.disable();
 			updateDraw.disable();
+			transformSync.disable();
 			completeDraw.disable();
 		}
 		return true;
@@ -157,10 +158,20 @@ bool GA::D3DRendererLogic::Activate(bool runSystem)
 	return false;
 }
 
+void GA::D3DRendererLogic::Render(float alpha)
+{
+	if (!startDraw.is_alive() || !startDraw.enabled())
+		return;
+	startDraw.run();
+	PrepareTransforms(alpha);
+	completeDraw.run();
+}
+
 bool GA::D3DRendererLogic::Shutdown()
 {
 	startDraw.destruct();
 	updateDraw.destruct();
+	transformSync.destruct();
 	completeDraw.destruct();
 	return true; // vulkan resource shutdown handled via GEvent in Init()
 }
@@ -522,18 +533,20 @@ bool GA::D3DRendererLogic::LoadGeometry()
 	proxy.Create();
 	inputProxy.Create(window);
 
-	Initialize3DVertexBuffer(creator);
-	Initialize3DIndexBuffer(creator);
+	// levels built from the same models share their geometry, the buffers from last time are still right
+	if (levelData->geometryKey == 0 || levelData->geometryKey != uploadedGeometry)
+	{
+		Initialize3DVertexBuffer(creator);
+		Initialize3DIndexBuffer(creator);
+		uploadedGeometry = levelData->geometryKey;
+	}
 	InitializeConstantBuffer(creator);
 	for (int i = 0; i < levelData->levelMaterials.size(); ++i)
 	{
 		mesh.material[i] = levelData->levelMaterials[i].attrib;
 	}
 
-	for (int i = 0; i < levelData->levelTransforms.size(); ++i)
-	{
-		mesh.worldMatrix[i] = levelData->levelTransforms[i];
-	}
+	ResetTransformStaging();
 	modelID.numLights = levelData->levelLighting.size();
 	modelID.mat_id = levelData->levelMeshes[0].materialIndex;
 	modelID.mod_id = levelData->levelInstances[0].modelIndex;
@@ -542,9 +555,6 @@ bool GA::D3DRendererLogic::LoadGeometry()
 		lights.myLights[i] = levelData->levelLighting[i];
 	}
 
-	Initialize3DVertexBuffer(creator);
-	Initialize3DIndexBuffer(creator);
-
 
 	unsigned int width;
 	unsigned int height;
@@ -846,20 +856,14 @@ bool GA::D3DRendererLogic::SetupDrawcalls() // I SCREWED THIS UP MAKES SO MUCH S
 	// An update system that iterates over all renderable components (may run multiple times)
 	// A post-update system that also runs only once rendering all collected data
 
-	// only happens once per frame
-	startDraw = game->system<RenderingSystem>().kind(flecs::PreUpdate)
+	// only happens once per frame, drawing has no phase so sim ticks skip it and Render runs it instead
+	startDraw = game->system<RenderingSystem>().kind(0)
 		.each([this](flecs::entity e, RenderingSystem& s) {
 		// reset the draw counter only once per frame
 		if (createEnt)
 		{
 			UpdateLevelEnt();
 			createEnt = false;
-		}
-		//loop over levelData->levelTransforms
-		//copy over to mesh.WorldMatrix[i] = levelTransforms
-		for (int i = 0; i < levelData->levelTransforms.size(); ++i)
-		{
-			mesh.worldMatrix[i] = levelData->levelTransforms[i];
 		}
 			});
 	// may run multiple times per frame, will run after startDraw
@@ -870,14 +874,60 @@ bool GA::D3DRendererLogic::SetupDrawcalls() // I SCREWED THIS UP MAKES SO MUCH S
 
 			});
 
-	// runs once per frame after updateDraw
-	completeDraw = game->system<Instance>().kind(flecs::PostUpdate)
+	// gameplay only edits ModelTransform, this copies the matrices that changed into the staging array
+	transformSync = game->system<const ModelTransform>("Transform Sync").kind(flecs::OnValidate)
+		.iter([this](flecs::iter& it, const ModelTransform* t) {
+		// first table of a new tick, whatever moved last tick and isn't written again has stopped
+		int64_t tick = it.world().get_tick();
+		if (tick != movingTick) {
+			for (unsigned index : moving) {
+				transformPrevious[index] = transformStaging[index];
+				MarkTransformDirty(index);
+			}
+			moving.clear();
+			movingTick = tick;
+		}
+		// skips tables nothing wrote to since last tick, flecs only sees writes to owned columns
+		if (it.changed()) {
+			for (auto i : it) {
+				unsigned index = t[i].rendererIndex;
+				if (index >= transformStaging.size() ||
+					!std::memcmp(&transformStaging[index], &t[i].matrix, sizeof(GW::MATH::GMATRIXF)))
+					continue;
+				if (writtenTick[index] != tick) {
+					transformPrevious[index] = transformStaging[index];
+					writtenTick[index] = tick;
+					moving.push_back(index);
+				}
+				transformStaging[index] = t[i].matrix;
+				MarkTransformDirty(index);
+			}
+		}
+		// a formation step rewrote every member this tick, the last row written must be what gets uploaded
+		// if it isn't, the change above was missed and the whole wave is frozen on screen
+		// release builds skip the lookups along with the assert
+#ifndef NDEBUG
+		if (it.count() && it.entity(0).has<FormationSlot>() && it.world().get<Formation>()->stepped) {
+			const ModelTransform& last = t[it.count() - 1];
+			assert(last.rendererIndex >= transformStaging.size() ||
+				!std::memcmp(&transformStaging[last.rendererIndex], &last.matrix, sizeof(GW::MATH::GMATRIXF)));
+		}
+#endif
+			});
+
+	// runs once per frame after startDraw, also started by Render
+	completeDraw = game->system<Instance>().kind(0)
 		.each([this](flecs::entity e, Instance& s) {
 
 		PipelineHandles curHandles = GetCurrentPipelineHandles();
 		SetUpPipeline(curHandles);
 		curHandles.context->UpdateSubresource(constantSceneBuffer.Get(), 0, nullptr, &scene, 0, 0);
-		curHandles.context->UpdateSubresource(constantMeshBuffer.Get(), 0, nullptr, &mesh, 0, 0);
+		// constant buffers only update whole, clean frames skip the upload (see PrepareTransforms)
+		if (meshDirty)
+		{
+			meshDirty = false;
+			curHandles.context->UpdateSubresource(constantMeshBuffer.Get(), 0, nullptr, &mesh, 0, 0);
+		}
 		curHandles.context->UpdateSubresource(constantLightBuffer.Get(), 0, nullptr, &lights, 0, 0);
 
 		modelID.mod_id = e.get<Instance>()->transformStart;
@@ -1024,7 +1074,7 @@ void GA::D3DRendererLogic::UIDraw()
 	curHandles.context->Unmap(vertexBufferDynamicTextHS.Get(), 0);
 
 	//set score text based on score
-	dynamicTextHS.SetText(std::to_string(int(*score)));
+	dynamicTextHS.SetText(std::to_string(gameState->score.load()));
 
 	dynamicTextHS.Update(width, height);
 	// upload the new information to the vertex buffer using map / unmap
@@ -1062,7 +1112,7 @@ void GA::D3DRendererLogic::UIDraw()
 	inputProxy.GetState(65, one);
 	inputProxy.GetState(66, two);
 
-	if (*youWin)
+	if (gameState->youWin)
 	{
 		conditionLose = false;
 		curHandles.context->IASetVertexBuffers(0, 1, vertexBufferStaticTextWin.GetAddressOf(), strides, offsets);
@@ -1078,7 +1128,7 @@ void GA::D3DRendererLogic::UIDraw()
 		curHandles.context->Draw(staticTextWin.GetVertices().size(), 0);
 		conditionWin = true;
 	}
-	if (*youLose)
+	if (gameState->youLose)
 	{
 		conditionWin = false;
 		curHandles.context->IASetVertexBuffers(0, 1, vertexBufferStaticTextLose.GetAddressOf(), strides, offsets);
@@ -1169,6 +1219,9 @@ void GA::D3DRendererLogic::ChooseLevel()
 							std::string base_file = fileName.substr(fileName.find_last_of("/\\") + 1);
 							std::string search = "../" + base_file;
 							GW::SYSTEM::GLog log;
+							// old handles point at entities about to be destroyed
+							game->set<LevelEntities>({});
+							game->set<Formation>({}); // the next wave starts marching from its level layout
 							for (int i = 0; i < entityVec.size(); ++i)
 							{
 								entityVec[i].destruct();
@@ -1183,8 +1236,8 @@ void GA::D3DRendererLogic::ChooseLevel()
 
 							}
 							(*levelChange) = false;
-							(*youLose) = false;
-							(*youWin) = false;
+							gameState->youLose = false;
+							gameState->youWin = false;
 							CoTaskMemFree(filePath);
 							pShellItem->Release();
 						}
@@ -1202,6 +1255,9 @@ void GA::D3DRendererLogic::LevelSwitch()
 	if (*levelChange)
 	{
 		GW::SYSTEM::GLog log;
+		// old handles point at entities about to be destroyed
+		game->set<LevelEntities>({});
+		game->set<Formation>({}); // the next wave starts marching from its level layout
 		for (int i = 0; i < entityVec.size(); ++i)
 		{
 			entityVec[i].destruct();
@@ -1233,10 +1289,57 @@ void GA::D3DRendererLogic::LevelSwitch()
 
 		}
 		(*levelChange) = false;
-		(*youWin) = false;
+		gameState->youWin = false;
 	}
 
 }
+// start the staging array over from the freshly loaded level, everything needs uploading
+void GA::D3DRendererLogic::ResetTransformStaging()
+{
+	// the constant buffer holds a fixed number of matrices
+	size_t count = G_SMALLER(levelData->levelTransforms.size(), std::size(mesh.worldMatrix));
+	transformStaging.assign(levelData->levelTransforms.begin(), levelData->levelTransforms.begin() + count);
+	transformPrevious = transformStaging;
+	writtenTick.assign(count, -1);
+	moving.clear();
+	dirtyBegin = 0;
+	dirtyEnd = static_cast<unsigned>(count);
+}
+// copies what changed into the mesh constant buffer and blends the slots that are moving
+void GA::D3DRendererLogic::PrepareTransforms(float alpha)
+{
+	// the range limits the copy, transformStaging holds the latest tick
+	if (dirtyBegin < dirtyEnd)
+	{
+		std::copy(transformStaging.begin() + dirtyBegin, transformStaging.begin() + dirtyEnd,
+			mesh.worldMatrix + dirtyBegin);
+		dirtyBegin = dirtyEnd = 0;
+		meshDirty = true;
+	}
+	if (!interpolate)
+		return;
+	// draw moving slots part way between the last two ticks, the blend changes every frame
+	for (unsigned index : moving) {
+		const GW::MATH::GMATRIXF& from = transformPrevious[index];
+		const GW::MATH::GMATRIXF& to = transformStaging[index];
+		float x = to.row4.x - from.row4.x, y = to.row4.y - from.row4.y;
+		if (x * x + y * y > 25.0f)
+			continue; // teleported (kicked off screen, respawned), just show where it ended up
+		GW::MATH::GMatrix::LerpF(from, to, alpha, mesh.worldMatrix[index]);
+		meshDirty = true;
+	}
+}
+// grow the range waiting to be uploaded so it covers index
+void GA::D3DRendererLogic::MarkTransformDirty(unsigned index)
+{
+	if (dirtyBegin == dirtyEnd) {
+		dirtyBegin = index;
+		dirtyEnd = index + 1;
+		return;
+	}
+	dirtyBegin = G_SMALLER(dirtyBegin, index);
+	dirtyEnd = G_LARGER(dirtyEnd, index + 1);
+}
 void GA::D3DRendererLogic::UpdateLevelEnt()
 {
 	for (auto& i : levelData->blenderObjects) 
@@ -1270,6 +1373,8 @@ void GA::D3DRendererLogic::UpdateLevelEnt()
 		entityVec.push_back(ent);
 	}
 	CreatePlayer();
+	// resolve named entities once so systems don't have to every frame
+	game->set<LevelEntities>(LevelEntities::Find(*game));
 }
 
 void GA::D3DRendererLogic::CreatePlayer()
@@ -1293,6 +1398,7 @@ void GA::D3DRendererLogic::CreatePlayer()
 	if (e.is_valid()) {
 		e.add<Player>();
 		e.add<Collidable>();
+		e.set<CollisionLayer>({ LAYER_PLAYER });
 		e.set<Material>({ red, green, blue });
 		e.set<Position>({ xstart, ystart });
 		e.set<ControllerID>({ 0 });
@@ -1300,6 +1406,7 @@ void GA::D3DRendererLogic::CreatePlayer()
 	auto a = game->lookup("shield");
 	if (a.is_valid()) {
 		a.add<Collidable>();
+		a.set<CollisionLayer>({ LAYER_SHIELD });
 		a.set<Material>({ red1, green1, blue1 });
 	}
 }
@@ -1321,6 +1428,7 @@ void GA::D3DRendererLogic::CreateEnemies()
 	auto a = game->lookup("Spaceship5.008");
 	if (a.is_valid()) {
 		a.override<Enemy>();
+		a.set<CollisionLayer>({ LAYER_ENEMY });
 		a.set_override<Health>({ health });
 		a.set<Material>({ red, green , blue });
 		a.add<Orientation>();
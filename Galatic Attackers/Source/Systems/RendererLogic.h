@@ -8,6 +8,7 @@
 
 // Contains our global game settings
 #include "../GameConfig.h"
+#include "../Components/Gameplay.h"
 #include "../../Source/HUD/Font.h"
 #include "../../Source/HUD/Sprite.h"
 // example space game (avoid name collisions)
@@ -60,21 +61,33 @@ namespace GA
 		// handle to our running ECS systems
 		flecs::system startDraw;
 		flecs::system updateDraw;
+		flecs::system transformSync;
 		flecs::system completeDraw;
+		// latest transform of every renderer slot, filled by Transform Sync
+		std::vector<GW::MATH::GMATRIXF> transformStaging;
+		// [dirtyBegin, dirtyEnd) of transformStaging hasn't reached the constant buffer yet
+		unsigned dirtyBegin = 0, dirtyEnd = 0;
+		// where slots that moved in the latest sim tick were one tick earlier, drawn blended in between
+		bool interpolate = true;
+		std::vector<GW::MATH::GMATRIXF> transformPrevious;
+		std::vector<int64_t> writtenTick; // sim tick each slot was last written in
+		std::vector<unsigned> moving; // slots written in movingTick
+		int64_t movingTick = -1;
+		// the mesh constant buffer changed since it was last uploaded
+		bool meshDirty = false;
 		// Used to query screen dimensions
 		GW::SYSTEM::GWindow window;
 		GW::MATH::GMatrix proxy;
 		std::shared_ptr<bool> levelChange;
-		std::shared_ptr<bool> youWin;
-		std::shared_ptr<bool> youLose;
 		std::shared_ptr<int> currentLevel;
-		std::shared_ptr<int> score;
+		flecs::ref<GameState> gameState;
 		std::vector<flecs::entity> entityVec;
 		// Directx11 resources used for rendering
 		std::shared_ptr<Level_Data> levelData;
 		GW::GRAPHICS::GDirectX11Surface direct11;
 		Microsoft::WRL::ComPtr<ID3D11Buffer>		vertexBuffer3D;
 		Microsoft::WRL::ComPtr<ID3D11Buffer>	    indexBuffer3D;
+		uint64_t uploadedGeometry = 0; // levelData->geometryKey of what the two buffers above hold
 		Microsoft::WRL::ComPtr<ID3D11Buffer>		vertexBuffer2D;
 		Microsoft::WRL::ComPtr<ID3D11Buffer>	    indexBuffer2D;
 		Microsoft::WRL::ComPtr<ID3D11VertexShader>	vertexShader3D;
@@ -150,10 +163,12 @@ namespace GA
 			std::weak_ptr<const GameConfig> _gameConfig,
 			GW::GRAPHICS::GDirectX11Surface _direct11,
 			GW::SYSTEM::GWindow _window, std::shared_ptr<Level_Data> _levelData, 
-			std::shared_ptr<bool> _levelChange, std::shared_ptr<bool> _youWin, std::shared_ptr<bool> _youLose,
-			std::vector<flecs::entity> _entityVec, std::shared_ptr<int> _currentLevel, std::shared_ptr<int> _score);
+			std::shared_ptr<bool> _levelChange,
+			std::vector<flecs::entity> _entityVec, std::shared_ptr<int> _currentLevel);
 		// control if the system is actively running
 		bool Activate(bool runSystem);
+		// draws one frame, alpha is how far (0 - 1) the clock has got from the last sim tick to the next
+		void Render(float alpha);
 		// release any resources allocated by the system
 		bool Shutdown();
 	private:
@@ -197,6 +212,9 @@ namespace GA
 		void LevelSwitch();
 		void ChooseLevel();
 		void UpdateLevelEnt();
+		void ResetTransformStaging();
+		void MarkTransformDirty(unsigned index);
+		void PrepareTransforms(float alpha);
 		void CreatePlayer();
 		void CreateEnemies();
 		void CreateBullets();
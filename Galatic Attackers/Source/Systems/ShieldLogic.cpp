@@ -14,12 +14,17 @@ bool GA::ShieldLogic::Init(std::shared_ptr<flecs::world> _game,
 	game = _game;
 	gameConfig = _gameConfig;
 
-	// destroy any bullets that have the CollidedWith relationship
+	// damage anything touching a shield this frame
 	game->system<Shield, Damage>("Shield System")
 		.each([](flecs::entity e, Shield, Damage& d) {
+		const Contacts* contacts = e.world().get<Contacts>();
+		if (contacts == nullptr)
+			return;
+		bool touched = false;
 		// damage anything we come into contact with
-		e.each<CollidedWith>([&e, d](flecs::entity hit) {
-			if (hit.has<Health>()) {
+		contacts->each(e, [&e, &touched, d](flecs::entity hit) {
+			touched = true;
+			if (hit.is_alive() && hit.has<Health>()) {
 				int current = hit.get<Health>()->value;
 				hit.set<Health>({ current - d.value });
 				// reduce the amount of hits but the charged shot
@@ -30,8 +35,8 @@ bool GA::ShieldLogic::Init(std::shared_ptr<flecs::world> _game,
 				}
 			}
 			});
-		// if you have collidedWith realtionship then be destroyed
-		if (e.has<CollidedWith>(flecs::Wildcard)) {
+		// if you touched anything then be destroyed
+		if (touched) {
 
 			if (e.has<ChargedShot>()) {
 
@@ -0,0 +1,51 @@
+#include "Broadphase.h"
+
+namespace
+{
+	// GCollision::TestOBBToOBBF pads every rotation term by 0.000001f so boxes that are
+	// just touching still collide. Grow each interval a little more than that so the
+	// broadphase can never reject a pair the narrowphase would have accepted.
+	constexpr float slopScale = 0.0001f;
+	constexpr float slopMin = 0.0001f;
+
+	// half width of an OBB along world X (same quaternion expansion Gateware uses)
+	float HalfWidthX(const GW::MATH::GOBBF& box)
+	{
+		const GW::MATH::GQUATERNIONF& q = box.rotation;
+		float yy2 = 2.0f * q.y * q.y;
+		float zz2 = 2.0f * q.z * q.z;
+		float xy2 = 2.0f * q.x * q.y;
+		float xz2 = 2.0f * q.x * q.z;
+		float wy2 = 2.0f * q.w * q.y;
+		float wz2 = 2.0f * q.w * q.z;
+		// X component of each of the box's local axes
+		float half = box.extent.x * G_ABS(1.0f - yy2 - zz2) +
+			box.extent.y * G_ABS(xy2 + wz2) +
+			box.extent.z * G_ABS(xz2 - wy2);
+		float slop = (box.extent.x + box.extent.y + box.extent.z) * slopScale + slopMin;
+		return half + slop;
+	}
+}
+
+void GA::SweepAndPrune::Update(const GW::MATH::GOBBF* boxes, unsigned count)
+{
+	intervals.resize(count);
+	for (unsigned i = 0; i < count; ++i) {
+		float half = HalfWidthX(boxes[i]);
+		intervals[i] = { boxes[i].center.x - half, boxes[i].center.x + half, i };
+	}
+	// insertion sort would be nicer for coherent frames, but the cache is rebuilt
+	// from the ECS query every frame so the order isn't stable enough to rely on
+	std::sort(intervals.begin(), intervals.end(), [](const INTERVAL& a, const INTERVAL& b) {
+		return a.min < b.min;
+	});
+}
+
+unsigned GA::SweepAndPrune::Overlaps(unsigned position) const
+{
+	// sweep: only look right until an interval starts past this one's end
+	unsigned end = position + 1;
+	while (end < intervals.size() && intervals[end].min <= intervals[position].max)
+		++end;
+	return end - position - 1;
+}
@@ -0,0 +1,30 @@
+// Sweep and prune broadphase, culls collision pairs before any OBB math runs
+#ifndef BROADPHASE_H
+#define BROADPHASE_H
+
+// example space game (avoid name collisions)
+namespace GA
+{
+	class SweepAndPrune
+	{
+		// one box projected onto the playfield X axis
+		struct INTERVAL {
+			float min, max;
+			unsigned index; // location of the box in the array passed to Update
+		};
+		// kept between frames so we don't reallocate (and mostly stays sorted)
+		std::vector<INTERVAL> intervals;
+	public:
+		struct PAIR {
+			unsigned first, second; // always first < second
+		};
+		// projects each OBB onto the X axis and sorts them left to right
+		void Update(const GW::MATH::GOBBF* boxes, unsigned count);
+		// index (into the boxes given to Update) of the box at this sorted position
+		unsigned Sorted(unsigned position) const { return intervals[position].index; }
+		// how many boxes right after this sorted position overlap it (they are always contiguous)
+		unsigned Overlaps(unsigned position) const;
+	};
+};
+
+#endif
@@ -0,0 +1,78 @@
+// Fixed size ring that many threads can push into and one thread drains, nobody ever waits on a lock
+#ifndef COMMANDQUEUE_H
+#define COMMANDQUEUE_H
+
+// example space game (avoid name collisions)
+namespace GA
+{
+	// every cell carries a sequence number saying whose turn it is (Dmitry Vyukov's bounded queue)
+	// producers race for a slot with one compare-exchange, the consumer side needs no atomics of its own
+	template<typename T, unsigned Capacity>
+	class CommandQueue
+	{
+		static_assert(Capacity && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+	public:
+		CommandQueue()
+		{
+			for (unsigned i = 0; i < Capacity; ++i)
+				cells[i].sequence.store(i, std::memory_order_relaxed);
+		}
+		// safe from any thread, returns false (and counts the drop) instead of waiting when full
+		bool Push(const T& command)
+		{
+			unsigned pos = tail.load(std::memory_order_relaxed);
+			for (;;) {
+				CELL& cell = cells[pos & (Capacity - 1)];
+				unsigned sequence = cell.sequence.load(std::memory_order_acquire);
+				int lag = static_cast<int>(sequence - pos);
+				if (lag == 0) {
+					if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+						break;
+				}
+				else if (lag < 0) {
+					dropped.fetch_add(1, std::memory_order_relaxed);
+					return false;
+				}
+				else
+					pos = tail.load(std::memory_order_relaxed);
+			}
+			CELL& cell = cells[pos & (Capacity - 1)];
+			cell.value = command;
+			cell.sequence.store(pos + 1, std::memory_order_release); // hands the cell to the consumer
+			return true;
+		}
+		// consumer thread only, calls func for every published command in push order
+		// stops early at a command a producer is still writing, it will be picked up next time
+		template<typename FUNC>
+		unsigned Drain(FUNC&& func)
+		{
+			unsigned drained = 0;
+			for (;;) {
+				CELL& cell = cells[head & (Capacity - 1)];
+				if (cell.sequence.load(std::memory_order_acquire) != head + 1)
+					break;
+				func(static_cast<const T&>(cell.value));
+				cell.sequence.store(head + Capacity, std::memory_order_release); // free for the next lap
+				++head;
+				++drained;
+			}
+			return drained;
+		}
+		// consumer thread only, commands claimed but not drained yet
+		unsigned Depth() const { return tail.load(std::memory_order_relaxed) - head; }
+		// pushes refused because the ring was full, since the queue was made
+		unsigned Dropped() const { return dropped.load(std::memory_order_relaxed); }
+	private:
+		struct CELL {
+			std::atomic<unsigned> sequence;
+			T value;
+		};
+		// producers and the consumer touch different ends, keep them off each other's cache line
+		alignas(64) std::atomic<unsigned> tail{ 0 };
+		alignas(64) unsigned head = 0;
+		std::atomic<unsigned> dropped{ 0 };
+		CELL cells[Capacity];
+	};
+}
+
+#endif
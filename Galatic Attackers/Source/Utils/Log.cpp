@@ -0,0 +1,124 @@
+#include "Log.h"
+#include <charconv>
+
+namespace
+{
+	std::atomic<int> runtimeLevel{ GA::LOG_INFO };
+	// the ring holds records of [level][length][text] back to back, oldest get overwritten
+	// records wrap around the end of the buffer byte by byte so none of the space is wasted
+	std::mutex ringLock;
+	std::vector<char> ring;
+	size_t ringHead = 0, ringUsed = 0; // where the oldest record starts and how many bytes are in use
+	constexpr size_t Record_Header = 3; // 1 byte level, 2 bytes length
+
+	char RingByte(size_t offset) { return ring[(ringHead + offset) % ring.size()]; }
+	void RingWrite(size_t offset, const char* bytes, size_t count) {
+		for (size_t i = 0; i < count; ++i)
+			ring[(ringHead + offset + i) % ring.size()] = bytes[i];
+	}
+	// drops whole records from the front until there is room for need bytes
+	void RingMakeRoom(size_t need) {
+		while (ring.size() - ringUsed < need) {
+			size_t length = static_cast<unsigned char>(RingByte(1)) |
+				(static_cast<size_t>(static_cast<unsigned char>(RingByte(2))) << 8);
+			size_t record = Record_Header + length;
+			ringHead = (ringHead + record) % ring.size();
+			ringUsed -= record;
+		}
+	}
+}
+
+void GA::Logger::Configure(LOG_LEVEL level, unsigned ringBytes)
+{
+	runtimeLevel.store(level, std::memory_order_relaxed);
+	std::lock_guard<std::mutex> hold(ringLock);
+	ring.assign(ringBytes, '\0');
+	ringHead = ringUsed = 0;
+}
+
+GA::LOG_LEVEL GA::Logger::Level()
+{
+	return static_cast<LOG_LEVEL>(runtimeLevel.load(std::memory_order_relaxed));
+}
+
+bool GA::Logger::ParseLevel(const std::string& name, LOG_LEVEL& outLevel)
+{
+	for (int level = LOG_INFO; level <= LOG_OFF; ++level) {
+		if (name == Category(static_cast<LOG_LEVEL>(level))) {
+			outLevel = static_cast<LOG_LEVEL>(level);
+			return true;
+		}
+	}
+	return false;
+}
+
+const char* GA::Logger::Category(LOG_LEVEL level)
+{
+	static const char* names[] = { "INFO", "MESSAGE", "EVENT", "WARNING", "ERROR", "OFF" };
+	return names[level];
+}
+
+void GA::Logger::DumpRing(std::ostream& out)
+{
+	std::lock_guard<std::mutex> hold(ringLock);
+	std::string text;
+	for (size_t offset = 0; offset < ringUsed;) {
+		LOG_LEVEL level = static_cast<LOG_LEVEL>(RingByte(offset));
+		size_t length = static_cast<unsigned char>(RingByte(offset + 1)) |
+			(static_cast<size_t>(static_cast<unsigned char>(RingByte(offset + 2))) << 8);
+		text.resize(length);
+		for (size_t i = 0; i < length; ++i)
+			text[i] = RingByte(offset + Record_Header + i);
+		out << '[' << Category(level) << "] " << text << '\n';
+		offset += Record_Header + length;
+	}
+}
+
+void GA::Logger::LINE::Append(std::string_view piece)
+{
+	size_t room = sizeof(text) - 1 - G_SMALLER(length, sizeof(text) - 1);
+	size_t count = G_SMALLER(room, piece.size());
+	std::memcpy(text + length, piece.data(), count);
+	length += count;
+}
+
+void GA::Logger::LINE::Append(double number)
+{
+	char digits[64];
+	int count = std::snprintf(digits, sizeof(digits), "%f", number);
+	if (count > 0)
+		Append(std::string_view(digits, G_SMALLER(static_cast<size_t>(count), sizeof(digits) - 1)));
+}
+
+void GA::Logger::LINE::Append(long long number)
+{
+	char digits[24];
+	auto result = std::to_chars(digits, digits + sizeof(digits), number);
+	Append(std::string_view(digits, result.ptr - digits));
+}
+
+void GA::Logger::LINE::Append(unsigned long long number)
+{
+	char digits[24];
+	auto result = std::to_chars(digits, digits + sizeof(digits), number);
+	Append(std::string_view(digits, result.ptr - digits));
+}
+
+void GA::Logger::Send(LOG_LEVEL level, const LINE& line)
+{
+	{
+		std::lock_guard<std::mutex> hold(ringLock);
+		size_t record = Record_Header + line.length;
+		if (ring.size() >= record) {
+			RingMakeRoom(record);
+			char header[Record_Header] = { static_cast<char>(level),
+				static_cast<char>(line.length & 0xFF), static_cast<char>(line.length >> 8) };
+			RingWrite(ringUsed, header, Record_Header);
+			RingWrite(ringUsed + Record_Header, line.text, line.length);
+			ringUsed += record;
+			if (level < LOG_WARNING)
+				return; // production builds keep the noise in memory, problems still reach the log
+		}
+	}
+	sink.LogCategorized(Category(level), line.text);
+}
@@ -0,0 +1,90 @@
+// Level filtered logging on top of GW::SYSTEM::GLog, messages are only put together if they will be kept
+#ifndef LOG_H
+#define LOG_H
+
+#include <string_view>
+
+// example space game (avoid name collisions)
+namespace GA
+{
+	// lowest to highest, named after the GLog categories they are written under
+	enum LOG_LEVEL { LOG_INFO, LOG_MESSAGE, LOG_EVENT, LOG_WARNING, LOG_ERROR, LOG_OFF };
+}
+
+// anything below this is compiled out entirely, define it on the command line to override
+#ifndef GA_LOG_COMPILE_LEVEL
+	#ifdef NDEBUG
+		#define GA_LOG_COMPILE_LEVEL GA::LOG_EVENT
+	#else
+		#define GA_LOG_COMPILE_LEVEL GA::LOG_INFO
+	#endif
+#endif
+
+namespace GA
+{
+	class Logger
+	{
+	public:
+		explicit Logger(GW::SYSTEM::GLog _sink) : sink(_sink) {}
+
+		// arguments are only turned into text when the level is on, e.g. Info("Location: X ", x, " Y ", y)
+		template<typename... ARGS> void Info(const ARGS&... args) { Write<LOG_INFO>(args...); }
+		template<typename... ARGS> void Message(const ARGS&... args) { Write<LOG_MESSAGE>(args...); }
+		template<typename... ARGS> void Event(const ARGS&... args) { Write<LOG_EVENT>(args...); }
+		template<typename... ARGS> void Warning(const ARGS&... args) { Write<LOG_WARNING>(args...); }
+		template<typename... ARGS> void Error(const ARGS&... args) { Write<LOG_ERROR>(args...); }
+
+		// process wide settings ([Logging] in the config), ringBytes 0 sends everything straight to GLog
+		// with a ring, kept messages go to memory instead and only warnings and errors still reach GLog
+		static void Configure(LOG_LEVEL level, unsigned ringBytes);
+		static LOG_LEVEL Level();
+		// "INFO" ... "ERROR", "OFF", anything else leaves outLevel alone and returns false
+		static bool ParseLevel(const std::string& name, LOG_LEVEL& outLevel);
+		// used when [Logging] level is missing a valid name, same as defaults.ini
+		static constexpr LOG_LEVEL Default_Level = LOG_WARNING;
+		static const char* Category(LOG_LEVEL level);
+		// writes what the ring still holds, oldest first, one line per message
+		static void DumpRing(std::ostream& out);
+
+		template<LOG_LEVEL LEVEL>
+		static constexpr bool Compiled() { return LEVEL >= GA_LOG_COMPILE_LEVEL; }
+		template<LOG_LEVEL LEVEL>
+		static bool Enabled() { return Compiled<LEVEL>() && LEVEL >= Level(); }
+
+	private:
+		// a message is put together on the stack, anything past the end is cut off
+		struct LINE {
+			char text[512];
+			size_t length = 0;
+			void Append(std::string_view piece);
+			void Append(const char* piece) { Append(std::string_view(piece ? piece : "(null)")); }
+			void Append(const std::string& piece) { Append(std::string_view(piece)); }
+			void Append(char piece) { Append(std::string_view(&piece, 1)); }
+			void Append(double number); // same digits as std::to_string
+			void Append(float number) { Append(static_cast<double>(number)); }
+			void Append(long long number);
+			void Append(unsigned long long number);
+			void Append(int number) { Append(static_cast<long long>(number)); }
+			void Append(long number) { Append(static_cast<long long>(number)); }
+			void Append(unsigned number) { Append(static_cast<unsigned long long>(number)); }
+			void Append(unsigned long number) { Append(static_cast<unsigned long long>(number)); }
+		};
+
+		template<LOG_LEVEL LEVEL, typename... ARGS>
+		void Write(const ARGS&... args) {
+			if constexpr (Compiled<LEVEL>()) {
+				if (LEVEL < Level())
+					return;
+				LINE line;
+				(line.Append(args), ...);
+				line.text[G_SMALLER(line.length, sizeof(line.text) - 1)] = '\0';
+				Send(LEVEL, line);
+			}
+		}
+		void Send(LOG_LEVEL level, const LINE& line);
+
+		GW::SYSTEM::GLog sink;
+	};
+};
+
+#endif
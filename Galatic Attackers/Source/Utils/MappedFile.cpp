@@ -0,0 +1,71 @@
+#include "MappedFile.h"
+#ifdef _WIN32
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+bool GA::MappedFile::Open(const char* path)
+{
+	Close();
+#ifdef _WIN32
+	HANDLE handle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (handle == INVALID_HANDLE_VALUE)
+		return false;
+	LARGE_INTEGER length;
+	if (!GetFileSizeEx(handle, &length) || length.QuadPart == 0) {
+		CloseHandle(handle);
+		return false;
+	}
+	HANDLE view = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (view == nullptr) {
+		CloseHandle(handle);
+		return false;
+	}
+	data = static_cast<const unsigned char*>(MapViewOfFile(view, FILE_MAP_READ, 0, 0, 0));
+	if (data == nullptr) {
+		CloseHandle(view);
+		CloseHandle(handle);
+		return false;
+	}
+	file = handle;
+	mapping = view;
+	size = static_cast<size_t>(length.QuadPart);
+#else
+	int handle = open(path, O_RDONLY);
+	if (handle < 0)
+		return false;
+	struct stat info;
+	if (fstat(handle, &info) != 0 || info.st_size == 0) {
+		close(handle);
+		return false;
+	}
+	void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, handle, 0);
+	close(handle); // the mapping keeps the file alive on its own
+	if (view == MAP_FAILED)
+		return false;
+	data = static_cast<const unsigned char*>(view);
+	size = static_cast<size_t>(info.st_size);
+#endif
+	return true;
+}
+
+void GA::MappedFile::Close()
+{
+	if (data == nullptr)
+		return;
+#ifdef _WIN32
+	UnmapViewOfFile(data);
+	CloseHandle(mapping);
+	CloseHandle(file);
+	file = mapping = nullptr;
+#else
+	munmap(const_cast<unsigned char*>(data), size);
+#endif
+	data = nullptr;
+	size = 0;
+}
@@ -0,0 +1,30 @@
+// Read-only view of a whole file mapped into memory, pages load on first touch instead of being copied
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+// example space game (avoid name collisions)
+namespace GA
+{
+	class MappedFile
+	{
+	public:
+		MappedFile() = default;
+		~MappedFile() { Close(); }
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+		// maps the file, anything mapped before is released first
+		bool Open(const char* path);
+		void Close();
+		const unsigned char* Data() const { return data; }
+		size_t Size() const { return size; }
+	private:
+		const unsigned char* data = nullptr;
+		size_t size = 0;
+#ifdef _WIN32
+		void* file = nullptr; // HANDLEs, kept as void* so windows.h stays out of this header
+		void* mapping = nullptr;
+#endif
+	};
+};
+
+#endif
@@ -0,0 +1,263 @@
+#include "OBBBatch.h"
+
+// pick the widest instruction set the compiler is allowed to use
+#if defined(__AVX__)
+	#define OBB_BATCH_AVX
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define OBB_BATCH_SSE
+#endif
+#if defined(OBB_BATCH_AVX) || defined(OBB_BATCH_SSE)
+	#include <immintrin.h>
+#endif
+
+namespace
+{
+	using GA::OBBBatch;
+
+	// Each "lane" type wraps one instruction set so the test below is only written once.
+	// Every operation is a plain multiply/add/subtract in the exact order GCollision uses
+	// (no fused multiply-add) so all three paths give bit-for-bit the same answers.
+	struct ScalarLane
+	{
+		using type = float;
+		using mask = bool;
+		static constexpr unsigned width = 1;
+		static type set(float v) { return v; }
+		static type gather(const float* p, const unsigned* at) { return p[at[0]]; }
+		static type add(type a, type b) { return a + b; }
+		static type sub(type a, type b) { return a - b; }
+		static type mul(type a, type b) { return a * b; }
+		static type abs(type a) { return G_ABS(a); }
+		static mask greater(type a, type b) { return a > b; }
+		static mask either(mask a, mask b) { return a || b; }
+		static type select(mask m, type a, type b) { return m ? a : b; }
+		static unsigned bits(mask m) { return m ? 1u : 0u; }
+	};
+
+#if defined(OBB_BATCH_SSE)
+	struct SSELane
+	{
+		using type = __m128;
+		using mask = __m128;
+		static constexpr unsigned width = 4;
+		static type set(float v) { return _mm_set1_ps(v); }
+		static type gather(const float* p, const unsigned* at) { return _mm_setr_ps(p[at[0]], p[at[1]], p[at[2]], p[at[3]]); }
+		static type add(type a, type b) { return _mm_add_ps(a, b); }
+		static type sub(type a, type b) { return _mm_sub_ps(a, b); }
+		static type mul(type a, type b) { return _mm_mul_ps(a, b); }
+		static type abs(type a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+		static mask greater(type a, type b) { return _mm_cmpgt_ps(a, b); }
+		static mask either(mask a, mask b) { return _mm_or_ps(a, b); }
+		static type select(mask m, type a, type b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+		static unsigned bits(mask m) { return static_cast<unsigned>(_mm_movemask_ps(m)); }
+	};
+#endif
+
+#if defined(OBB_BATCH_AVX)
+	struct AVXLane
+	{
+		using type = __m256;
+		using mask = __m256;
+		static constexpr unsigned width = 8;
+		static type set(float v) { return _mm256_set1_ps(v); }
+		static type gather(const float* p, const unsigned* at) {
+			return _mm256_setr_ps(p[at[0]], p[at[1]], p[at[2]], p[at[3]], p[at[4]], p[at[5]], p[at[6]], p[at[7]]);
+		}
+		static type add(type a, type b) { return _mm256_add_ps(a, b); }
+		static type sub(type a, type b) { return _mm256_sub_ps(a, b); }
+		static type mul(type a, type b) { return _mm256_mul_ps(a, b); }
+		static type abs(type a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+		static mask greater(type a, type b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+		static mask either(mask a, mask b) { return _mm256_or_ps(a, b); }
+		static type select(mask m, type a, type b) { return _mm256_blendv_ps(b, a, m); }
+		static unsigned bits(mask m) { return static_cast<unsigned>(_mm256_movemask_ps(m)); }
+	};
+#endif
+
+	// Lane by lane copy of GCollision::TestOBBToOBBF, returns which lanes are separated.
+	// Instead of returning at the first separating axis every axis is tested, the answer is the same.
+	template<typename L>
+	typename L::mask Separated(const typename L::type* a, const typename L::type* b)
+	{
+		using T = typename L::type;
+		const T zero = L::set(0.0f);
+		const T epsilon = L::set(0.000001f);
+		// rotation axes have a w of 0, GVector::DotF still adds it in
+		T rotation[3][3], abs_rotation[3][3];
+		for (int i = 0; i < 3; ++i) {
+			for (int j = 0; j < 3; ++j) {
+				T dot = L::add(L::add(L::add(
+					L::mul(a[OBBBatch::AXIS_0X + i * 3], b[OBBBatch::AXIS_0X + j * 3]),
+					L::mul(a[OBBBatch::AXIS_0Y + i * 3], b[OBBBatch::AXIS_0Y + j * 3])),
+					L::mul(a[OBBBatch::AXIS_0Z + i * 3], b[OBBBatch::AXIS_0Z + j * 3])),
+					L::mul(zero, zero));
+				rotation[i][j] = dot;
+				abs_rotation[i][j] = L::add(L::abs(dot), epsilon);
+			}
+		}
+		// translation brought into a's coordinate frame
+		T difference[4] = {
+			L::sub(b[OBBBatch::CENTER_X], a[OBBBatch::CENTER_X]),
+			L::sub(b[OBBBatch::CENTER_Y], a[OBBBatch::CENTER_Y]),
+			L::sub(b[OBBBatch::CENTER_Z], a[OBBBatch::CENTER_Z]),
+			L::sub(b[OBBBatch::CENTER_W], a[OBBBatch::CENTER_W])
+		};
+		T t[3];
+		for (int i = 0; i < 3; ++i) {
+			t[i] = L::add(L::add(L::add(
+				L::mul(difference[0], a[OBBBatch::AXIS_0X + i * 3]),
+				L::mul(difference[1], a[OBBBatch::AXIS_0Y + i * 3])),
+				L::mul(difference[2], a[OBBBatch::AXIS_0Z + i * 3])),
+				L::mul(difference[3], zero));
+		}
+		const T* ae = a + OBBBatch::EXTENT_X;
+		const T* be = b + OBBBatch::EXTENT_X;
+		typename L::mask separated = L::greater(zero, zero); // all false
+		// axes of a
+		for (int i = 0; i < 3; ++i) {
+			T radii = L::add(ae[i], L::add(L::add(
+				L::mul(be[0], abs_rotation[i][0]),
+				L::mul(be[1], abs_rotation[i][1])),
+				L::mul(be[2], abs_rotation[i][2])));
+			separated = L::either(separated, L::greater(L::abs(t[i]), radii));
+		}
+		// axes of b
+		for (int i = 0; i < 3; ++i) {
+			T radii = L::add(L::add(L::add(
+				L::mul(ae[0], abs_rotation[0][i]),
+				L::mul(ae[1], abs_rotation[1][i])),
+				L::mul(ae[2], abs_rotation[2][i])), be[i]);
+			T axis = L::add(L::add(
+				L::mul(t[0], rotation[0][i]),
+				L::mul(t[1], rotation[1][i])),
+				L::mul(t[2], rotation[2][i]));
+			separated = L::either(separated, L::greater(L::abs(axis), radii));
+		}
+		// the 9 edge cross products, written out to mirror GCollision term for term
+		auto edge = [&](T radii1, T radii2, T axis) {
+			separated = L::either(separated, L::greater(L::abs(axis), L::add(radii1, radii2)));
+		};
+		// a x & b x
+		edge(L::add(L::mul(ae[1], abs_rotation[2][0]), L::mul(ae[2], abs_rotation[1][0])),
+			L::add(L::mul(be[1], abs_rotation[0][2]), L::mul(be[2], abs_rotation[0][1])),
+			L::sub(L::mul(t[2], rotation[1][0]), L::mul(t[1], rotation[2][0])));
+		// a x & b y
+		edge(L::add(L::mul(ae[1], abs_rotation[2][1]), L::mul(ae[2], abs_rotation[1][1])),
+			L::add(L::mul(be[0], abs_rotation[0][2]), L::mul(be[2], abs_rotation[0][0])),
+			L::sub(L::mul(t[2], rotation[1][1]), L::mul(t[1], rotation[2][1])));
+		// a x & b z
+		edge(L::add(L::mul(ae[1], abs_rotation[2][2]), L::mul(ae[2], abs_rotation[1][2])),
+			L::add(L::mul(be[0], abs_rotation[0][1]), L::mul(be[1], abs_rotation[0][0])),
+			L::sub(L::mul(t[2], rotation[1][2]), L::mul(t[1], rotation[2][2])));
+		// a y & b x
+		edge(L::add(L::mul(ae[0], abs_rotation[2][0]), L::mul(ae[2], abs_rotation[0][0])),
+			L::add(L::mul(be[1], abs_rotation[1][2]), L::mul(be[2], abs_rotation[1][1])),
+			L::sub(L::mul(t[0], rotation[2][0]), L::mul(t[2], rotation[0][0])));
+		// a y & b y
+		edge(L::add(L::mul(ae[0], abs_rotation[2][1]), L::mul(ae[2], abs_rotation[0][1])),
+			L::add(L::mul(be[0], abs_rotation[1][2]), L::mul(be[2], abs_rotation[1][0])),
+			L::sub(L::mul(t[0], rotation[2][1]), L::mul(t[2], rotation[0][1])));
+		// a y & b z
+		edge(L::add(L::mul(ae[0], abs_rotation[2][2]), L::mul(ae[2], abs_rotation[0][2])),
+			L::add(L::mul(be[0], abs_rotation[1][1]), L::mul(be[1], abs_rotation[1][0])),
+			L::sub(L::mul(t[0], rotation[2][2]), L::mul(t[2], rotation[0][2])));
+		// a z & b x
+		edge(L::add(L::mul(ae[0], abs_rotation[1][0]), L::mul(ae[1], abs_rotation[0][0])),
+			L::add(L::mul(be[1], abs_rotation[2][2]), L::mul(be[2], abs_rotation[2][1])),
+			L::sub(L::mul(t[1], rotation[0][0]), L::mul(t[0], rotation[1][0])));
+		// a z & b y
+		edge(L::add(L::mul(ae[0], abs_rotation[1][1]), L::mul(ae[1], abs_rotation[0][1])),
+			L::add(L::mul(be[0], abs_rotation[2][2]), L::mul(be[2], abs_rotation[2][0])),
+			L::sub(L::mul(t[1], rotation[0][1]), L::mul(t[0], rotation[1][1])));
+		// a z & b z
+		edge(L::add(L::mul(ae[0], abs_rotation[1][2]), L::mul(ae[1], abs_rotation[0][2])),
+			L::add(L::mul(be[0], abs_rotation[2][1]), L::mul(be[1], abs_rotation[2][0])),
+			L::sub(L::mul(t[1], rotation[0][2]), L::mul(t[0], rotation[1][2])));
+		return separated;
+	}
+
+	// tests "one" against the L::width boxes listed in at, writes a 1 for every hit
+	template<typename L>
+	void TestLanes(const std::vector<float>* fields, unsigned one, const unsigned* at, unsigned char* outHits)
+	{
+		using T = typename L::type;
+		T single[OBBBatch::FIELD_COUNT], many[OBBBatch::FIELD_COUNT];
+		for (int f = 0; f < OBBBatch::FIELD_COUNT; ++f) {
+			single[f] = L::set(fields[f][one]);
+			many[f] = L::gather(fields[f].data(), at);
+		}
+		// whichever box has the lower order goes first (GCollision is not symmetric)
+		typename L::mask manyFirst = L::greater(single[OBBBatch::ORDER], many[OBBBatch::ORDER]);
+		T first[OBBBatch::FIELD_COUNT], second[OBBBatch::FIELD_COUNT];
+		for (int f = 0; f < OBBBatch::FIELD_COUNT; ++f) {
+			first[f] = L::select(manyFirst, many[f], single[f]);
+			second[f] = L::select(manyFirst, single[f], many[f]);
+		}
+		unsigned separated = L::bits(Separated<L>(first, second));
+		for (unsigned i = 0; i < L::width; ++i)
+			outHits[i] = ((separated >> i) & 1u) ? 0 : 1;
+	}
+}
+
+void GA::OBBBatch::Add(const GW::MATH::GOBBF& box, unsigned order)
+{
+	// same quaternion expansion GCollision::TestOBBToOBBF does for every test
+	const GW::MATH::GQUATERNIONF& q = box.rotation;
+	float xx2 = 2.0f * q.x * q.x;
+	float yy2 = 2.0f * q.y * q.y;
+	float zz2 = 2.0f * q.z * q.z;
+	float xy2 = 2.0f * q.x * q.y;
+	float xz2 = 2.0f * q.x * q.z;
+	float yz2 = 2.0f * q.y * q.z;
+	float wx2 = 2.0f * q.w * q.x;
+	float wy2 = 2.0f * q.w * q.y;
+	float wz2 = 2.0f * q.w * q.z;
+	const float values[FIELD_COUNT] = {
+		static_cast<float>(order),
+		box.center.x, box.center.y, box.center.z, box.center.w,
+		box.extent.x, box.extent.y, box.extent.z,
+		1.0f - yy2 - zz2, xy2 - wz2, xz2 + wy2,
+		xy2 + wz2, 1.0f - xx2 - zz2, yz2 - wx2,
+		xz2 - wy2, yz2 + wx2, 1.0f - xx2 - yy2
+	};
+	for (int f = 0; f < FIELD_COUNT; ++f)
+		fields[f].push_back(values[f]);
+	++count;
+}
+
+void GA::OBBBatch::Clear()
+{
+	for (int f = 0; f < FIELD_COUNT; ++f)
+		fields[f].clear();
+	count = 0;
+}
+
+void GA::OBBBatch::TestList(unsigned one, const unsigned* others, unsigned listSize, unsigned char* outHits) const
+{
+	unsigned done = 0;
+	if (useSimd) {
+#if defined(OBB_BATCH_AVX)
+		for (; done + AVXLane::width <= listSize; done += AVXLane::width)
+			TestLanes<AVXLane>(fields, one, others + done, outHits + done);
+#endif
+#if defined(OBB_BATCH_SSE)
+		for (; done + SSELane::width <= listSize; done += SSELane::width)
+			TestLanes<SSELane>(fields, one, others + done, outHits + done);
+#endif
+	}
+	// whatever doesn't fill a full register
+	for (; done < listSize; ++done)
+		TestLanes<ScalarLane>(fields, one, others + done, outHits + done);
+}
+
+const char* GA::OBBBatch::SimdPath()
+{
+#if defined(OBB_BATCH_AVX)
+	return "avx";
+#elif defined(OBB_BATCH_SSE)
+	return "sse";
+#else
+	return "scalar";
+#endif
+}
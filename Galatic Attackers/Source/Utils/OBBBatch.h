@@ -0,0 +1,41 @@
+// Structure of arrays copy of the level's OBBs, tests one box against many at once
+#ifndef OBBBATCH_H
+#define OBBBATCH_H
+
+// example space game (avoid name collisions)
+namespace GA
+{
+	class OBBBatch
+	{
+	public:
+		// every value the OBB test needs, each one gets its own contiguous array
+		// rotations are stored already expanded into 3 axes (same math as GCollision)
+		enum FIELD {
+			ORDER, // original index of the box, decides which box the test is done relative to
+			CENTER_X, CENTER_Y, CENTER_Z, CENTER_W,
+			EXTENT_X, EXTENT_Y, EXTENT_Z,
+			AXIS_0X, AXIS_0Y, AXIS_0Z,
+			AXIS_1X, AXIS_1Y, AXIS_1Z,
+			AXIS_2X, AXIS_2Y, AXIS_2Z,
+			FIELD_COUNT
+		};
+		// copies a box into the arrays, order is the index used to break ties (see TestList)
+		void Add(const GW::MATH::GOBBF& box, unsigned order);
+		// empties the arrays but keeps their capacity
+		void Clear();
+		unsigned Size() const { return count; }
+		// tests box "one" against the listSize boxes in others, outHits[i] is 1 if it touches others[i]
+		// GCollision::TestOBBToOBBF is done relative to its first box, so each pair is tested with
+		// the box of lower order first. This keeps results identical to calling it directly.
+		void TestList(unsigned one, const unsigned* others, unsigned listSize, unsigned char* outHits) const;
+		// name of the widest instruction set TestList was compiled with ("avx", "sse" or "scalar")
+		static const char* SimdPath();
+		// set false to force the scalar code path (used for comparisons)
+		bool useSimd = true;
+	private:
+		std::vector<float> fields[FIELD_COUNT];
+		unsigned count = 0;
+	};
+};
+
+#endif
@@ -0,0 +1,94 @@
+#include "Random.h"
+#include <random>
+
+namespace
+{
+	std::atomic<uint64_t> baseSeed{ 1 };
+	// bumped by SeedAll so threads know to restart their sequence
+	std::atomic<unsigned> generation{ 0 };
+	std::atomic<unsigned> threadCount{ 0 };
+
+	// spreads one 64 bit value into well mixed ones, used for all seeding
+	uint64_t SplitMix64(uint64_t& x)
+	{
+		uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		return z ^ (z >> 31);
+	}
+
+	uint32_t Rotl(uint32_t x, int k) { return (x << k) | (x >> (32 - k)); }
+}
+
+void GA::Random::Seed(uint64_t seed)
+{
+	// xoshiro must never be all zeros, splitmix can't produce that from two outputs
+	uint64_t a = SplitMix64(seed), b = SplitMix64(seed);
+	state[0] = static_cast<uint32_t>(a);
+	state[1] = static_cast<uint32_t>(a >> 32);
+	state[2] = static_cast<uint32_t>(b);
+	state[3] = static_cast<uint32_t>(b >> 32);
+}
+
+uint32_t GA::Random::Next()
+{
+	uint32_t result = Rotl(state[1] * 5, 7) * 9;
+	uint32_t t = state[1] << 9;
+	state[2] ^= state[0];
+	state[3] ^= state[1];
+	state[1] ^= state[2];
+	state[0] ^= state[3];
+	state[2] ^= t;
+	state[3] = Rotl(state[3], 11);
+	return result;
+}
+
+void GA::Random::Fill(float* out, unsigned count, float low, float high)
+{
+	// keep the state in registers for the whole batch instead of going through memory per number
+	Random local = *this;
+	float scale = (high - low) * (1.0f / 16777216.0f);
+	for (unsigned i = 0; i < count; ++i)
+		out[i] = low + (local.Next() >> 8) * scale;
+	*this = local;
+}
+
+uint64_t GA::Random::SeedAll(uint64_t seed)
+{
+	// kept to 32 bits so the printed seed fits back in the config
+	if (seed == 0) {
+		std::random_device rd;
+		do seed = rd(); while (seed == 0);
+	}
+	baseSeed.store(seed, std::memory_order_relaxed);
+	threadCount.store(0, std::memory_order_relaxed);
+	generation.fetch_add(1, std::memory_order_release);
+	return seed;
+}
+
+uint64_t GA::Random::BaseSeed()
+{
+	return baseSeed.load(std::memory_order_relaxed);
+}
+
+GA::Random& GA::Random::Local()
+{
+	thread_local Random generator;
+	thread_local unsigned seenGeneration = ~0u;
+	unsigned current = generation.load(std::memory_order_acquire);
+	if (seenGeneration != current) {
+		uint64_t ordinal = threadCount.fetch_add(1, std::memory_order_relaxed);
+		generator.Seed(BaseSeed() ^ SplitMix64(ordinal));
+		seenGeneration = current;
+	}
+	return generator;
+}
+
+GA::Random GA::Random::Stream(const char* name)
+{
+	// FNV-1a of the name keeps streams apart without having to hand out numbers
+	uint64_t hash = 0xCBF29CE484222325ull;
+	for (; *name; ++name)
+		hash = (hash ^ static_cast<unsigned char>(*name)) * 0x100000001B3ull;
+	return Random(BaseSeed() ^ hash);
+}
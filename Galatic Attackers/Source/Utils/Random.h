@@ -0,0 +1,37 @@
+// Small fast random numbers for gameplay, one generator per thread so nothing is shared or locked
+#ifndef RANDOM_H
+#define RANDOM_H
+
+// example space game (avoid name collisions)
+namespace GA
+{
+	// xoshiro128** (Blackman & Vigna), 16 bytes of state and a handful of shifts per number
+	class Random
+	{
+	public:
+		explicit Random(uint64_t seed = 1) { Seed(seed); }
+		// same seed gives the same sequence on every machine
+		void Seed(uint64_t seed);
+		uint32_t Next();
+		// [0, 1) with the 24 bits a float can hold
+		float Uniform() { return (Next() >> 8) * (1.0f / 16777216.0f); }
+		// [low, high)
+		float Range(float low, float high) { return low + (high - low) * Uniform(); }
+		// fills count floats in [low, high), cheaper than calling Range in a loop
+		void Fill(float* out, unsigned count, float low, float high);
+
+		// sets the seed every thread and stream starts from, 0 picks one from std::random_device
+		// returns the seed used so a session can be played back with it ([Random] seed)
+		static uint64_t SeedAll(uint64_t seed);
+		static uint64_t BaseSeed();
+		// this thread's generator, safe to use from any system including worker threads
+		// threads are numbered in the order they first ask, so only single threaded users are reproducible
+		static Random& Local();
+		// its own sequence that only depends on the seed and name, for things that must replay exactly
+		static Random Stream(const char* name);
+	private:
+		uint32_t state[4];
+	};
+};
+
+#endif
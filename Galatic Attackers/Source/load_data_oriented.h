@@ -4,6 +4,14 @@
 
 // This reads .h2b files which are optimized binary .obj+.mtl files
 #include "h2bParser.h"
+// Cooked .glv level packs are mapped instead of read
+#include "Utils/MappedFile.h"
+#include "Utils/Log.h"
+#include <filesystem>
+#include <map>
+#include <thread>
+#include <charconv>
+#include <string_view>
 
 class Level_Data {
 
@@ -39,9 +47,22 @@ public:
 		const char* blendername; // *NEW* name of model straight from blender (FLECS)
 		unsigned int modelIndex, transformIndex;
 	};
+	// read-only array, points at vectors filled from the text level or straight into a mapped .glv
+	template<typename T>
+	struct LEVEL_VIEW
+	{
+		const T* ptr = nullptr;
+		size_t count = 0;
+		const T* data() const { return ptr; }
+		size_t size() const { return count; }
+		bool empty() const { return count == 0; }
+		const T& operator[](size_t i) const { return ptr[i]; }
+		const T* begin() const { return ptr; }
+		const T* end() const { return ptr + count; }
+	};
 	// All geometry data combined for level to be loaded onto the video card
-	std::vector<H2B::VERTEX> levelVertices;
-	std::vector<unsigned> levelIndices;
+	LEVEL_VIEW<H2B::VERTEX> levelVertices;
+	LEVEL_VIEW<unsigned> levelIndices;
 	// All material data used by the level
 	std::vector<H2B::MATERIAL> levelMaterials;
 	// This could be populated by the Level_Renderer during GPU transfer
@@ -59,55 +80,115 @@ public:
 	// *NEW* each item from the blender scene graph
 	std::vector<BLENDER_OBJECT> blenderObjects;
 	std::vector<LIGHT_SETTINGS> levelLighting;
+	// same models in the same order give the same key, so the GPU copy of the geometry can be kept (0 = unknown)
+	uint64_t geometryKey = 0;
 	
 	// Imports the default level txt format and collects all .h2b data
+	// A cooked .glv next to the .txt (see CookLevel) is mapped instead, unless the .txt is newer
 	bool LoadLevel(	const char* gameLevelPath, 
 					const char* h2bFolderPath, 
 					GW::SYSTEM::GLog log) {
-		// What this does:
-		// Parse GameLevel.txt 
-		// For each model found in the file...
-			// if not encountered create new unique temporary model entry.
-				// Add model transform to a list of transforms for this model.(instances)
-			// if already encountered, just add its transfrom to the existing model entry.
-		// when finished, traverse model entries to import each model's data to the class.
-		std::set<MODEL_ENTRY> uniqueModels; // unique models and their locations
-		log.LogCategorized("EVENT", "LOADING GAME LEVEL [DATA ORIENTED]");
-
+		GA::Logger out(log); // filtered by [Logging] level, messages below it are never built
 		UnloadLevel();// clear previous level data if there is any
-		if (ReadGameLevel(gameLevelPath, uniqueModels, log) == false) {
-			log.LogCategorized("ERROR", "Fatal error reading game level, aborting level load.");
-			return false;
+		std::string packPath = PackPath(gameLevelPath);
+		if (PackIsCurrent(gameLevelPath, packPath)) {
+			if (LoadPack(packPath.c_str(), out))
+				return true;
+			out.Warning("Cooked level unusable, reading the text level instead.");
+			UnloadLevel();
 		}
-		if (ReadAndCombineH2Bs(h2bFolderPath, uniqueModels, log) == false) {
-			log.LogCategorized("ERROR", "Fatal error combining H2B mesh data, aborting level load.");
+		return LoadText(gameLevelPath, h2bFolderPath, out);
+	}
+	// Offline step: reads the text level and its .h2b files and saves them as one .glv pack
+	// The pack must be cooked again after any of the models change, editing the .txt is noticed
+	bool CookLevel(	const char* gameLevelPath,
+					const char* h2bFolderPath,
+					GW::SYSTEM::GLog log) {
+		GA::Logger out(log);
+		UnloadLevel();
+		if (LoadText(gameLevelPath, h2bFolderPath, out) == false)
 			return false;
-		}
-		// level loaded into CPU ram
-		log.LogCategorized("EVENT", "GAME LEVEL WAS LOADED TO CPU [DATA ORIENTED]");
-		return true;
+		return WritePack(PackPath(gameLevelPath).c_str(), out);
 	}
 	// used to wipe CPU level data between levels
 	void UnloadLevel() {
 		level_strings.clear();
-		levelVertices.clear();
-		levelIndices.clear();
+		vertexStorage.clear();
+		indexStorage.clear();
+		levelVertices = {};
+		levelIndices = {};
 		levelMaterials.clear();
 		levelTextures.clear();
 		levelBatches.clear();
 		levelMeshes.clear();
 		levelModels.clear();
 		levelTransforms.clear();
+		levelColliders.clear();
 		levelInstances.clear();
 		blenderObjects.clear();
 		levelLighting.clear();
+		geometryKey = 0;
+		pack.Close();
+	}
+	// parsed .h2b files stay resident across levels until they pass this many bytes, least recently used go first
+	// 0 empties the cache and turns it off
+	void SetModelCacheBudget(size_t bytes) {
+		modelCacheBudget = bytes;
+		TrimModelCache();
 	}
+	size_t ModelCacheBytes() const { return modelCacheBytes; }
 	// *NO RENDERING/GPU/DRAW LOGIC IN HERE PLEASE* 
 	// *DATA ORIENTED SHOULD AIM TO SEPERATE DATA FROM THE LOGIC THAT USES IT*
 	// The Level Renderer class is a good place to utilize this data.
 	// You can use your chosen API to have one GPU buffer for each type of data.
 	// Then you loop through instances using the API features to draw each mesh only once.
 private:
+	// backing for the geometry views when the level came from text
+	std::vector<H2B::VERTEX> vertexStorage;
+	std::vector<unsigned> indexStorage;
+	// backing for the geometry views and every string when the level came from a .glv
+	GA::MappedFile pack;
+	// one parsed .h2b, checked against the file's size and write time so an edited model is read again
+	struct CACHED_MODEL
+	{
+		H2B::Parser model;
+		uintmax_t fileSize = 0;
+		std::filesystem::file_time_type writeTime;
+		size_t bytes = 0;
+		uint64_t lastUsed = 0;
+		bool valid = false;
+	};
+	std::map<std::string, CACHED_MODEL> modelCache; // by .h2b path
+	uint64_t cacheClock = 0; // bumped once per level, stamps lastUsed
+	size_t modelCacheBytes = 0, modelCacheBudget = 64 << 20;
+
+	bool LoadText(	const char* gameLevelPath,
+					const char* h2bFolderPath,
+					GA::Logger& out) {
+		// What this does:
+		// Parse GameLevel.txt 
+		// For each model found in the file...
+			// if not encountered create new unique temporary model entry.
+				// Add model transform to a list of transforms for this model.(instances)
+			// if already encountered, just add its transfrom to the existing model entry.
+		// when finished, traverse model entries to import each model's data to the class.
+		std::set<MODEL_ENTRY> uniqueModels; // unique models and their locations
+		out.Event("LOADING GAME LEVEL [DATA ORIENTED]");
+
+		if (ReadGameLevel(gameLevelPath, uniqueModels, out) == false) {
+			out.Error("Fatal error reading game level, aborting level load.");
+			return false;
+		}
+		if (ReadAndCombineH2Bs(h2bFolderPath, uniqueModels, out) == false) {
+			out.Error("Fatal error combining H2B mesh data, aborting level load.");
+			return false;
+		}
+		// level loaded into CPU ram
+		levelVertices = { vertexStorage.data(), vertexStorage.size() };
+		levelIndices = { indexStorage.data(), indexStorage.size() };
+		out.Event("GAME LEVEL WAS LOADED TO CPU [DATA ORIENTED]");
+		return true;
+	}
 	// internal defintion for reading the GameLevel layout 
 	struct MODEL_ENTRY
 	{
@@ -137,63 +218,93 @@ private:
 		}
 	
 	};
+	// walks the level text in place, lines and numbers are read without copying anything
+	struct TEXT_CURSOR
+	{
+		const char* at;
+		const char* end;
+		unsigned line = 0; // for error messages
+		bool Done() const { return at >= end; }
+		// next line with surrounding whitespace (and any '\r') trimmed off
+		std::string_view NextLine() {
+			const char* start = at;
+			while (at < end && *at != '\n')
+				++at;
+			const char* stop = at;
+			if (at < end)
+				++at; // past the '\n'
+			++line;
+			while (start < stop && std::isspace(static_cast<unsigned char>(*start)))
+				++start;
+			while (stop > start && std::isspace(static_cast<unsigned char>(stop[-1])))
+				--stop;
+			return std::string_view(start, stop - start);
+		}
+		// reads count floats from the next line, they follow the first '(' and are split by commas/spaces
+		// "<Matrix 4x4 (1.0, 0.0, 0.0, 0.0)", "(0.0, 1.0, 0.0, 0.0)" and "<Vector (1.0, 0.0, 1.0)>" all work
+		bool NextFloats(float* out, int count) {
+			std::string_view text = NextLine();
+			size_t open = text.find('(');
+			if (open == std::string_view::npos)
+				return false;
+			const char* p = text.data() + open + 1;
+			const char* stop = text.data() + text.size();
+			for (int i = 0; i < count; ++i) {
+				while (p < stop && (*p == ',' || *p == '+' || std::isspace(static_cast<unsigned char>(*p))))
+					++p;
+				auto result = std::from_chars(p, stop, out[i]);
+				if (result.ec != std::errc())
+					return false;
+				p = result.ptr;
+			}
+			return true;
+		}
+	};
 	// internal helper for reading the game level
+	// the whole file is mapped and parsed in one pass, no per line buffers or sscanf
 	bool ReadGameLevel(const char* gameLevelPath, 
 						std::set<MODEL_ENTRY> &outModels,
-						GW::SYSTEM::GLog log) {
-		log.LogCategorized("MESSAGE", "Begin Reading Game Level Text File.");
-		GW::SYSTEM::GFile file;
-		file.Create();
-		if (-file.OpenTextRead(gameLevelPath)) {
-			log.LogCategorized(
-				"ERROR", (std::string("Game level not found: ") + gameLevelPath).c_str());
+						GA::Logger& out) {
+		out.Message("Begin Reading Game Level Text File.");
+		GA::MappedFile file;
+		if (file.Open(gameLevelPath) == false) {
+			out.Error("Game level not found: ", gameLevelPath);
 			return false;
 		}
-		char linebuffer[1024];
-		while (+file.ReadLine(linebuffer, 1024, '\n'))
+		TEXT_CURSOR text = { reinterpret_cast<const char*>(file.Data()),
+			reinterpret_cast<const char*>(file.Data()) + file.Size() };
+		auto malformed = [&]() {
+			out.Error("Malformed game level ", gameLevelPath, " at line ", text.line);
+			return false;
+		};
+		while (text.Done() == false)
 		{
-			// having to have this is a bug, need to have Read/ReadLine return failure at EOF
-			if (linebuffer[0] == '\0')
-				break;
-			if (std::strcmp(linebuffer, "MESH") == 0)
+			std::string_view keyword = text.NextLine();
+			if (keyword == "MESH")
 			{
-				file.ReadLine(linebuffer, 1024, '\n');
-				std::string blenderName = linebuffer;
-				log.LogCategorized("INFO", (std::string("Model Detected: ") + blenderName).c_str());
+				std::string blenderName(text.NextLine());
+				out.Info("Model Detected: ", blenderName);
 				// create the model file name from this (strip the .001)
-				MODEL_ENTRY add = { linebuffer };
+				MODEL_ENTRY add = { blenderName };
 				add.modelFile = add.modelFile.substr(0, add.modelFile.find_last_of("."));
 				add.modelFile += ".h2b";
 
 				// now read the transform data as we will need that regardless
 				GW::MATH::GMATRIXF transform;
 				for (int i = 0; i < 4; ++i) {
-					file.ReadLine(linebuffer, 1024, '\n');
-					// read floats
-					std::sscanf(linebuffer + 13, "%f, %f, %f, %f",
-						&transform.data[0 + i * 4], &transform.data[1 + i * 4],
-						&transform.data[2 + i * 4], &transform.data[3 + i * 4]);
+					if (text.NextFloats(&transform.data[i * 4], 4) == false)
+						return malformed();
 				}
-				std::string loc = "Location: X ";
-				loc += std::to_string(transform.row4.x) + " Y " +
-					std::to_string(transform.row4.y) + " Z " + std::to_string(transform.row4.z);
-				log.LogCategorized("INFO", loc.c_str());
+				out.Info("Location: X ", transform.row4.x, " Y ", transform.row4.y, " Z ", transform.row4.z);
 
 				// *NEW* finally read in the boundry data for this model
 				for (int i = 0; i < 8; ++i) {
-					file.ReadLine(linebuffer, 1024, '\n');
-					// read floats
-					std::sscanf(linebuffer + 9, "%f, %f, %f",
-						&add.boundry[i].x, &add.boundry[i].y, &add.boundry[i].z);
+					if (text.NextFloats(&add.boundry[i].x, 3) == false)
+						return malformed();
 				}
-				std::string bounds = "Boundry: Left ";
-				bounds += std::to_string(add.boundry[0].x) +
-				" Right " +	std::to_string(add.boundry[4].x) +
-				" Bottom " + std::to_string(add.boundry[0].y) +
-				" Top " + std::to_string(add.boundry[1].y) +
-				" Near " + std::to_string(add.boundry[0].z) +
-				" Far " + std::to_string(add.boundry[2].z);
-				log.LogCategorized("INFO", bounds.c_str());
+				out.Info("Boundry: Left ", add.boundry[0].x, " Right ", add.boundry[4].x,
+					" Bottom ", add.boundry[0].y, " Top ", add.boundry[1].y,
+					" Near ", add.boundry[0].z, " Far ", add.boundry[2].z);
 
 				// does this model already exist?
 				auto found = outModels.find(add);
@@ -210,27 +321,17 @@ private:
 					found->instances.push_back(transform);
 				}
 			}
-
-			if (std::strcmp(linebuffer, "LIGHT") == 0)
+			else if (keyword == "LIGHT")
 			{
-				file.ReadLine(linebuffer, 1024, '\n');
-				std::string blenderName = linebuffer;
-				log.LogCategorized("INFO", (std::string("Model Detected: ") + blenderName).c_str());
-				// create the model file name from this (strip the .001)
-				MODEL_ENTRY add = { linebuffer };
-				add.modelFile = add.modelFile.substr(0, add.modelFile.find_last_of("."));
-				add.modelFile += ".h2b";
+				std::string blenderName(text.NextLine());
+				out.Info("Model Detected: ", blenderName);
 
 				// now read the transform data as we will need that regardless
 				GW::MATH::GMATRIXF transform;
 				for (int i = 0; i < 4; ++i) {
-					file.ReadLine(linebuffer, 1024, '\n');
-					// read floats
-					std::sscanf(linebuffer + 13, "%f, %f, %f, %f",
-						&transform.data[0 + i * 4], &transform.data[1 + i * 4],
-						&transform.data[2 + i * 4], &transform.data[3 + i * 4]);
+					if (text.NextFloats(&transform.data[i * 4], 4) == false)
+						return malformed();
 				}
-
 				LIGHT_SETTINGS light;
 				light.red = transform.data[0];
 				light.green = transform.data[1];
@@ -250,95 +351,375 @@ private:
 				light.cutoff = transform.data[15];
 				levelLighting.push_back(light);
 
-				std::string loc = "Location: X ";
-				loc += std::to_string(transform.row4.x) + " Y " +
-					std::to_string(transform.row4.y) + " Z " + std::to_string(transform.row4.z);
-				log.LogCategorized("INFO", loc.c_str());
-
+				out.Info("Location: X ", transform.row4.x, " Y ", transform.row4.y, " Z ", transform.row4.z);
 			}
 		}
-		log.LogCategorized("MESSAGE", "Game Level File Reading Complete.");
+		out.Message("Game Level File Reading Complete.");
 		return true;
 	}
+	// runs func(0) ... func(count - 1) spread over the hardware threads, returns once all are done
+	template<typename FUNC>
+	static void ParallelFor(size_t count, FUNC&& func) {
+		size_t threads = G_SMALLER(count, static_cast<size_t>(G_LARGER(1u, std::thread::hardware_concurrency())));
+		std::atomic<size_t> next{ 0 };
+		auto worker = [&]() {
+			for (size_t i = next++; i < count; i = next++)
+				func(i);
+		};
+		std::vector<std::thread> pool;
+		for (size_t t = 1; t < threads; ++t)
+			pool.emplace_back(worker);
+		worker(); // this thread helps instead of waiting
+		for (auto& t : pool)
+			t.join();
+	}
 	// internal helper for collecting all .h2b data into unified arrays
+	// models parse concurrently, offsets come from a running total, then each model copies into its own range
+	// the arrays end up exactly as if the models were appended one after another
 	bool ReadAndCombineH2Bs(const char* h2bFolderPath, 
 							const std::set<MODEL_ENTRY>& modelSet,
-							GW::SYSTEM::GLog log) {
-		log.LogCategorized("MESSAGE", "Begin Importing .H2B File Data.");
-		// parse each model adding to overall arrays
-		H2B::Parser p; // reads the .h2b format
+							GA::Logger& out) {
+		out.Message("Begin Importing .H2B File Data.");
+		// models resident from an earlier level are reused, only new or changed files are parsed (all at once)
 		const std::string modelPath = h2bFolderPath;
-		for (auto i = modelSet.begin(); i != modelSet.end(); ++i)
-		{
-			if (p.Parse((modelPath + "/" + i->modelFile).c_str()))
-			{
-				log.LogCategorized("INFO", (std::string("H2B Imported: ") + i->modelFile).c_str());
-				// transfer all string data
-				for (int j = 0; j < p.materialCount; ++j) {
-					for (int k = 0; k < 10; ++k) {
-						if (*((&p.materials[j].name) + k) != nullptr)
-							*((&p.materials[j].name) + k) =
-							level_strings.insert(*((&p.materials[j].name) + k)).first->c_str();
-					}
-				}
-				for (int j = 0; j < p.meshCount; ++j) {
-					if (p.meshes[j].name != nullptr)
-						p.meshes[j].name =
-						level_strings.insert(p.meshes[j].name).first->c_str();
-				}
-				// record source file name & sizes
-				LEVEL_MODEL model;
-				model.filename = level_strings.insert(i->modelFile).first->c_str();
-				model.vertexCount = p.vertexCount;
-				model.indexCount = p.indexCount;
-				model.materialCount = p.materialCount;
-				model.meshCount = p.meshCount;
-				// record offsets
-				model.vertexStart = levelVertices.size();
-				model.indexStart = levelIndices.size();
-				model.materialStart = levelMaterials.size();
-				model.batchStart = levelBatches.size();
-				model.meshStart = levelMeshes.size();
-				// append/move all data
-				levelVertices.insert(levelVertices.end(), p.vertices.begin(), p.vertices.end());
-				levelIndices.insert(levelIndices.end(), p.indices.begin(), p.indices.end());
-				levelMaterials.insert(levelMaterials.end(), p.materials.begin(), p.materials.end());
-				levelBatches.insert(levelBatches.end(), p.batches.begin(), p.batches.end());
-				levelMeshes.insert(levelMeshes.end(), p.meshes.begin(), p.meshes.end());
-				// *NEW* add overall collision volume(OBB) for this model and it's submeshes 
-				model.colliderIndex = levelColliders.size();
-				levelColliders.push_back(i->ComputeOBB());
-				// add level model
-				levelModels.push_back(model);
-				// add level model instances
-				MODEL_INSTANCES instances;
-				LIGHT_SETTINGS light;
-				instances.flags = 0; // shadows? transparency? much we could do with this.
-				instances.modelIndex = levelModels.size() - 1;
-				instances.transformStart = levelTransforms.size();
-				instances.transformCount = i->instances.size();
-				levelTransforms.insert(levelTransforms.end(), i->instances.begin(), i->instances.end());
-				// add instance set
-				levelInstances.push_back(instances);
-				
-				// *NEW* Add an entry for each unique blender object
-				int offset = 0;
-				for (auto &n : i->blenderNames) {
-					BLENDER_OBJECT obj {
-						level_strings.insert(n).first->c_str(),
-						instances.modelIndex, instances.transformStart + offset++
-					};
-					blenderObjects.push_back(obj);
-				}
+		std::vector<const MODEL_ENTRY*> entries;
+		for (const MODEL_ENTRY& entry : modelSet)
+			entries.push_back(&entry);
+		std::vector<CACHED_MODEL*> cached(entries.size());
+		std::vector<size_t> misses;
+		++cacheClock;
+		for (size_t i = 0; i < entries.size(); ++i) {
+			std::string path = modelPath + "/" + entries[i]->modelFile;
+			std::error_code sizeError, timeError;
+			uintmax_t size = std::filesystem::file_size(path, sizeError);
+			auto time = std::filesystem::last_write_time(path, timeError);
+			CACHED_MODEL& c = modelCache[path];
+			if (c.valid == false || sizeError || timeError || c.fileSize != size || c.writeTime != time) {
+				c = CACHED_MODEL();
+				c.fileSize = size;
+				c.writeTime = time;
+				misses.push_back(i);
 			}
-			else {
+			c.lastUsed = cacheClock;
+			cached[i] = &c;
+		}
+		ParallelFor(misses.size(), [&](size_t m) {
+			size_t i = misses[m];
+			CACHED_MODEL& c = *cached[i];
+			c.valid = c.model.Parse((modelPath + "/" + entries[i]->modelFile).c_str());
+			c.bytes = c.valid ? ModelBytes(c.model) : 0;
+		});
+		uint64_t key = 14695981039346656037ull; // FNV-1a over each model's path, size and write time
+		auto hash = [&key](const void* bytes, size_t count) {
+			for (size_t b = 0; b < count; ++b)
+				key = (key ^ static_cast<const unsigned char*>(bytes)[b]) * 1099511628211ull;
+		};
+		// in set order: strings, offsets and the small tables (level_strings isn't thread safe)
+		size_t vertexTotal = 0, indexTotal = 0, materialTotal = 0, batchTotal = 0, meshTotal = 0;
+		std::vector<size_t> firstModel(entries.size()); // where each parsed model landed in levelModels
+		for (size_t i = 0; i < entries.size(); ++i)
+		{
+			const MODEL_ENTRY* entry = entries[i];
+			const H2B::Parser& p = cached[i]->model;
+			if (cached[i]->valid == false) {
 				// notify user that a model file is missing but continue loading
-				log.LogCategorized("ERROR",
-					(std::string("H2B Not Found: ") + modelPath + "/" + i->modelFile).c_str());
-				log.LogCategorized("WARNING", "Loading will continue but model(s) are missing.");
+				out.Error("H2B Not Found: ", modelPath, "/", entry->modelFile);
+				out.Warning("Loading will continue but model(s) are missing.");
+				continue;
+			}
+			out.Info("H2B Imported: ", entry->modelFile);
+			hash(entry->modelFile.c_str(), entry->modelFile.size() + 1);
+			hash(&cached[i]->fileSize, sizeof(cached[i]->fileSize));
+			hash(&cached[i]->writeTime, sizeof(cached[i]->writeTime));
+			// record source file name & sizes
+			LEVEL_MODEL model;
+			model.filename = level_strings.insert(entry->modelFile).first->c_str();
+			model.vertexCount = p.vertexCount;
+			model.indexCount = p.indexCount;
+			model.materialCount = p.materialCount;
+			model.meshCount = p.meshCount;
+			// record offsets, the running totals are where the arrays would be if appended in order
+			model.vertexStart = vertexTotal;
+			model.indexStart = indexTotal;
+			model.materialStart = materialTotal;
+			model.batchStart = batchTotal;
+			model.meshStart = meshTotal;
+			vertexTotal += p.vertices.size();
+			indexTotal += p.indices.size();
+			materialTotal += p.materials.size();
+			batchTotal += p.batches.size();
+			meshTotal += p.meshes.size();
+			// *NEW* add overall collision volume(OBB) for this model and it's submeshes 
+			model.colliderIndex = levelColliders.size();
+			levelColliders.push_back(entry->ComputeOBB());
+			// add level model
+			firstModel[i] = levelModels.size();
+			levelModels.push_back(model);
+			// add level model instances
+			MODEL_INSTANCES instances;
+			instances.flags = 0; // shadows? transparency? much we could do with this.
+			instances.modelIndex = levelModels.size() - 1;
+			instances.transformStart = levelTransforms.size();
+			instances.transformCount = entry->instances.size();
+			levelTransforms.insert(levelTransforms.end(), entry->instances.begin(), entry->instances.end());
+			// add instance set
+			levelInstances.push_back(instances);
+
+			// *NEW* Add an entry for each unique blender object
+			int offset = 0;
+			for (auto &n : entry->blenderNames) {
+				BLENDER_OBJECT obj {
+					level_strings.insert(n).first->c_str(),
+					instances.modelIndex, instances.transformStart + offset++
+				};
+				blenderObjects.push_back(obj);
+			}
+		}
+		// size everything once, then every model fills its own range with no reallocation
+		vertexStorage.resize(vertexTotal);
+		indexStorage.resize(indexTotal);
+		levelMaterials.resize(materialTotal);
+		levelBatches.resize(batchTotal);
+		levelMeshes.resize(meshTotal);
+		ParallelFor(entries.size(), [&](size_t i) {
+			if (cached[i]->valid == false)
+				return;
+			const H2B::Parser& p = cached[i]->model;
+			const LEVEL_MODEL& model = levelModels[firstModel[i]];
+			std::copy(p.vertices.begin(), p.vertices.end(), vertexStorage.begin() + model.vertexStart);
+			std::copy(p.indices.begin(), p.indices.end(), indexStorage.begin() + model.indexStart);
+			std::copy(p.materials.begin(), p.materials.end(), levelMaterials.begin() + model.materialStart);
+			std::copy(p.batches.begin(), p.batches.end(), levelBatches.begin() + model.batchStart);
+			std::copy(p.meshes.begin(), p.meshes.end(), levelMeshes.begin() + model.meshStart);
+		});
+		// transfer all string data, the copies point into the cached parsers which may be evicted
+		for (H2B::MATERIAL& material : levelMaterials) {
+			for (int k = 0; k < 10; ++k) {
+				if (*((&material.name) + k) != nullptr)
+					*((&material.name) + k) =
+					level_strings.insert(*((&material.name) + k)).first->c_str();
 			}
 		}
-		log.LogCategorized("MESSAGE", "Importing of .H2B File Data Complete.");
+		for (H2B::MESH& mesh : levelMeshes) {
+			if (mesh.name != nullptr)
+				mesh.name = level_strings.insert(mesh.name).first->c_str();
+		}
+		geometryKey = key;
+		TrimModelCache();
+		out.Message("Models reused: ", entries.size() - misses.size(), " parsed: ", misses.size(),
+			" cache bytes: ", modelCacheBytes);
+		out.Message("Importing of .H2B File Data Complete.");
+		return true;
+	}
+	// rough resident size of a parsed model
+	static size_t ModelBytes(const H2B::Parser& p) {
+		size_t bytes = sizeof(H2B::Parser) +
+			p.vertices.capacity() * sizeof(H2B::VERTEX) + p.indices.capacity() * sizeof(unsigned) +
+			p.materials.capacity() * sizeof(H2B::MATERIAL) + p.batches.capacity() * sizeof(H2B::BATCH) +
+			p.meshes.capacity() * sizeof(H2B::MESH);
+		for (const H2B::MATERIAL& m : p.materials)
+			for (int k = 0; k < 10; ++k)
+				if (*((&m.name) + k) != nullptr)
+					bytes += std::strlen(*((&m.name) + k)) + 1;
+		for (const H2B::MESH& m : p.meshes)
+			if (m.name != nullptr)
+				bytes += std::strlen(m.name) + 1;
+		return bytes;
+	}
+	// drops failed parses, then the least recently used models until the cache fits its budget
+	void TrimModelCache() {
+		modelCacheBytes = 0;
+		for (auto it = modelCache.begin(); it != modelCache.end();) {
+			if (it->second.valid == false)
+				it = modelCache.erase(it);
+			else
+				modelCacheBytes += (it++)->second.bytes;
+		}
+		while (modelCacheBytes > modelCacheBudget) {
+			auto oldest = modelCache.begin();
+			for (auto it = modelCache.begin(); it != modelCache.end(); ++it)
+				if (it->second.lastUsed < oldest->second.lastUsed)
+					oldest = it;
+			modelCacheBytes -= oldest->second.bytes;
+			modelCache.erase(oldest);
+		}
+	}
+	// .glv layout: a header, then each array as its own 64 byte aligned section
+	// strings live in one section of '\0' terminated text and everything else refers to them by offset
+	enum GLV_SECTION {
+		GLV_VERTICES, GLV_INDICES, GLV_MATERIALS, GLV_BATCHES, GLV_MESHES, GLV_MODELS, GLV_TRANSFORMS,
+		GLV_COLLIDERS, GLV_INSTANCES, GLV_OBJECTS, GLV_LIGHTS, GLV_STRINGS, GLV_SECTION_COUNT
+	};
+	static constexpr unsigned GLV_VERSION = 1, GLV_ALIGN = 64, GLV_NO_STRING = ~0u;
+	struct GLV_HEADER {
+		char magic[4]; // "GLV\0"
+		unsigned version, sectionCount, padding;
+		struct { unsigned long long offset, count, stride; } sections[GLV_SECTION_COUNT];
+	};
+	struct GLV_MATERIAL { H2B::ATTRIBUTES attrib; unsigned names[10]; }; // same order as MATERIAL's strings
+	struct GLV_MESH { unsigned name; H2B::BATCH drawInfo; unsigned materialIndex; };
+	struct GLV_MODEL {
+		unsigned filename, vertexCount, indexCount, materialCount, meshCount;
+		unsigned vertexStart, indexStart, materialStart, meshStart, batchStart, colliderIndex;
+	};
+	struct GLV_OBJECT { unsigned name, modelIndex, transformIndex; };
+
+	// GameLevel_1.txt -> GameLevel_1.glv
+	static std::string PackPath(const char* gameLevelPath) {
+		return std::filesystem::path(gameLevelPath).replace_extension(".glv").string();
+	}
+	// a pack is used while it is at least as new as the text it was cooked from
+	static bool PackIsCurrent(const char* gameLevelPath, const std::string& packPath) {
+		std::error_code error;
+		auto packTime = std::filesystem::last_write_time(packPath, error);
+		if (error)
+			return false; // never cooked
+		auto textTime = std::filesystem::last_write_time(gameLevelPath, error);
+		return error || packTime >= textTime; // shipping the pack without the text is fine too
+	}
+	// saves what is loaded right now, must have come from text (strings are still char* here)
+	bool WritePack(const char* packPath, GA::Logger& out) const {
+		std::string strings;
+		std::map<std::string, unsigned> stringOffsets;
+		auto addString = [&](const char* text) {
+			if (text == nullptr)
+				return GLV_NO_STRING;
+			auto found = stringOffsets.emplace(text, static_cast<unsigned>(strings.size()));
+			if (found.second)
+				strings.append(text, std::strlen(text) + 1);
+			return found.first->second;
+		};
+		std::vector<GLV_MATERIAL> materials(levelMaterials.size());
+		for (size_t i = 0; i < levelMaterials.size(); ++i) {
+			materials[i].attrib = levelMaterials[i].attrib;
+			for (int k = 0; k < 10; ++k)
+				materials[i].names[k] = addString(*((&levelMaterials[i].name) + k));
+		}
+		std::vector<GLV_MESH> meshes(levelMeshes.size());
+		for (size_t i = 0; i < levelMeshes.size(); ++i)
+			meshes[i] = { addString(levelMeshes[i].name), levelMeshes[i].drawInfo, levelMeshes[i].materialIndex };
+		std::vector<GLV_MODEL> models(levelModels.size());
+		for (size_t i = 0; i < levelModels.size(); ++i) {
+			const LEVEL_MODEL& m = levelModels[i];
+			models[i] = { addString(m.filename), m.vertexCount, m.indexCount, m.materialCount, m.meshCount,
+				m.vertexStart, m.indexStart, m.materialStart, m.meshStart, m.batchStart, m.colliderIndex };
+		}
+		std::vector<GLV_OBJECT> objects(blenderObjects.size());
+		for (size_t i = 0; i < blenderObjects.size(); ++i)
+			objects[i] = { addString(blenderObjects[i].blendername),
+				blenderObjects[i].modelIndex, blenderObjects[i].transformIndex };
+
+		struct SOURCE { const void* data; size_t count, stride; } sources[GLV_SECTION_COUNT] = {
+			{ levelVertices.data(), levelVertices.size(), sizeof(H2B::VERTEX) },
+			{ levelIndices.data(), levelIndices.size(), sizeof(unsigned) },
+			{ materials.data(), materials.size(), sizeof(GLV_MATERIAL) },
+			{ levelBatches.data(), levelBatches.size(), sizeof(H2B::BATCH) },
+			{ meshes.data(), meshes.size(), sizeof(GLV_MESH) },
+			{ models.data(), models.size(), sizeof(GLV_MODEL) },
+			{ levelTransforms.data(), levelTransforms.size(), sizeof(GW::MATH::GMATRIXF) },
+			{ levelColliders.data(), levelColliders.size(), sizeof(GW::MATH::GOBBF) },
+			{ levelInstances.data(), levelInstances.size(), sizeof(MODEL_INSTANCES) },
+			{ objects.data(), objects.size(), sizeof(GLV_OBJECT) },
+			{ levelLighting.data(), levelLighting.size(), sizeof(LIGHT_SETTINGS) },
+			{ strings.data(), strings.size(), 1 },
+		};
+		// zeroed first so padding and unused bytes are written as 0 every time
+		GLV_HEADER header{};
+		std::memcpy(header.magic, "GLV", 4);
+		header.version = GLV_VERSION;
+		header.sectionCount = GLV_SECTION_COUNT;
+		unsigned long long offset = sizeof(GLV_HEADER);
+		for (int i = 0; i < GLV_SECTION_COUNT; ++i) {
+			offset = (offset + GLV_ALIGN - 1) / GLV_ALIGN * GLV_ALIGN;
+			header.sections[i] = { offset, sources[i].count, sources[i].stride };
+			offset += sources[i].count * sources[i].stride;
+		}
+
+		std::ofstream file(packPath, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+		if (file.is_open() == false) {
+			out.Error("Can't write cooked level: ", packPath);
+			return false;
+		}
+		static const char zeros[GLV_ALIGN] = {};
+		file.write(reinterpret_cast<const char*>(&header), sizeof(GLV_HEADER));
+		unsigned long long written = sizeof(GLV_HEADER);
+		for (int i = 0; i < GLV_SECTION_COUNT; ++i) {
+			file.write(zeros, header.sections[i].offset - written);
+			file.write(static_cast<const char*>(sources[i].data), sources[i].count * sources[i].stride);
+			written = header.sections[i].offset + sources[i].count * sources[i].stride;
+		}
+		if (!file) {
+			out.Error("Failed writing cooked level: ", packPath);
+			return false;
+		}
+		out.Event("Cooked level written: ", packPath);
+		return true;
+	}
+	template<typename T>
+	LEVEL_VIEW<T> PackSection(const GLV_HEADER& header, GLV_SECTION which) const {
+		return { reinterpret_cast<const T*>(pack.Data() + header.sections[which].offset),
+			static_cast<size_t>(header.sections[which].count) };
+	}
+	// maps a pack, geometry and names are used where they sit in the file, the small tables are copied
+	bool LoadPack(const char* packPath, GA::Logger& out) {
+		out.Event("LOADING COOKED GAME LEVEL [DATA ORIENTED]");
+		if (pack.Open(packPath) == false || pack.Size() < sizeof(GLV_HEADER)) {
+			out.Error("Cooked level not readable: ", packPath);
+			return false;
+		}
+		GLV_HEADER header;
+		std::memcpy(&header, pack.Data(), sizeof(GLV_HEADER));
+		static const size_t strides[GLV_SECTION_COUNT] = {
+			sizeof(H2B::VERTEX), sizeof(unsigned), sizeof(GLV_MATERIAL), sizeof(H2B::BATCH), sizeof(GLV_MESH),
+			sizeof(GLV_MODEL), sizeof(GW::MATH::GMATRIXF), sizeof(GW::MATH::GOBBF), sizeof(MODEL_INSTANCES),
+			sizeof(GLV_OBJECT), sizeof(LIGHT_SETTINGS), 1
+		};
+		bool valid = std::memcmp(header.magic, "GLV", 4) == 0 &&
+			header.version == GLV_VERSION && header.sectionCount == GLV_SECTION_COUNT;
+		for (int i = 0; valid && i < GLV_SECTION_COUNT; ++i) {
+			const auto& section = header.sections[i];
+			valid = section.stride == strides[i] && section.offset % GLV_ALIGN == 0 &&
+				section.offset <= pack.Size() && section.count <= (pack.Size() - section.offset) / section.stride;
+		}
+		const char* strings = reinterpret_cast<const char*>(pack.Data() + header.sections[GLV_STRINGS].offset);
+		size_t stringsSize = static_cast<size_t>(header.sections[GLV_STRINGS].count);
+		valid = valid && (stringsSize == 0 || strings[stringsSize - 1] == '\0');
+		if (valid == false) {
+			out.Error("Cooked level is damaged or out of date: ", packPath);
+			return false;
+		}
+		auto string = [&](unsigned offset) -> const char* {
+			return (offset < stringsSize) ? strings + offset : nullptr;
+		};
+		// zero copy, these go to the GPU straight from the mapped pages
+		levelVertices = PackSection<H2B::VERTEX>(header, GLV_VERTICES);
+		levelIndices = PackSection<unsigned>(header, GLV_INDICES);
+		// small tables, copied so they stay vectors and their names are turned back into pointers
+		for (const GLV_MATERIAL& m : PackSection<GLV_MATERIAL>(header, GLV_MATERIALS)) {
+			H2B::MATERIAL material{};
+			material.attrib = m.attrib;
+			for (int k = 0; k < 10; ++k)
+				*((&material.name) + k) = string(m.names[k]);
+			levelMaterials.push_back(material);
+		}
+		auto batches = PackSection<H2B::BATCH>(header, GLV_BATCHES);
+		levelBatches.assign(batches.begin(), batches.end());
+		for (const GLV_MESH& m : PackSection<GLV_MESH>(header, GLV_MESHES))
+			levelMeshes.push_back({ string(m.name), m.drawInfo, m.materialIndex });
+		for (const GLV_MODEL& m : PackSection<GLV_MODEL>(header, GLV_MODELS))
+			levelModels.push_back({ string(m.filename), m.vertexCount, m.indexCount, m.materialCount, m.meshCount,
+				m.vertexStart, m.indexStart, m.materialStart, m.meshStart, m.batchStart, m.colliderIndex });
+		auto transforms = PackSection<GW::MATH::GMATRIXF>(header, GLV_TRANSFORMS);
+		levelTransforms.assign(transforms.begin(), transforms.end());
+		auto colliders = PackSection<GW::MATH::GOBBF>(header, GLV_COLLIDERS);
+		levelColliders.assign(colliders.begin(), colliders.end());
+		auto instances = PackSection<MODEL_INSTANCES>(header, GLV_INSTANCES);
+		levelInstances.assign(instances.begin(), instances.end());
+		for (const GLV_OBJECT& o : PackSection<GLV_OBJECT>(header, GLV_OBJECTS))
+			blenderObjects.push_back({ string(o.name), o.modelIndex, o.transformIndex });
+		auto lights = PackSection<LIGHT_SETTINGS>(header, GLV_LIGHTS);
+		levelLighting.assign(lights.begin(), lights.end());
+		out.Event("COOKED GAME LEVEL WAS MAPPED [DATA ORIENTED]");
 		return true;
 	}
 };